@@ -30,6 +30,11 @@ protected:
     std::map<std::vector<int>, std::vector<std::vector<int>>> sToJMap_;    // s子集到包含它的j组的映射
     std::vector<std::vector<int>> allSSubsets_;                            // 所有可能的s子集
 
+    // 按组合数下标（combinadic rank）索引的稠密映射，下标即组合在 generate(samples_, r) 中的位置
+    std::vector<int> samples_;                                             // 组合数下标的基
+    std::vector<std::vector<size_t>> jToSRanks_;                           // j组下标 -> 其s子集的下标
+    std::vector<std::vector<size_t>> sToJRanks_;                           // s子集下标 -> 包含它的j组的下标
+
     // 组合生成结果结构
     struct CombinationResult {
         std::vector<std::vector<int>> groups;           // k组候选集
@@ -37,6 +42,8 @@ protected:
         std::vector<std::vector<int>> allSSubsets;      // 所有s子集
         std::map<std::vector<int>, std::vector<std::vector<int>>> jToSMap; // j到s的映射
         std::map<std::vector<int>, std::vector<std::vector<int>>> sToJMap; // s到j的映射
+        std::vector<std::vector<size_t>> jToSRanks;     // j下标到s下标的稠密映射
+        std::vector<std::vector<size_t>> sToJRanks;     // s下标到j下标的稠密映射
     };
 
     // 生成组合并建立映射关系
@@ -53,12 +60,13 @@ public:
     explicit BaseSolver(const Config& config) : m_config(config) {}
     virtual ~BaseSolver() = default;
 
-    // 验证解决方案
+    // 验证解决方案；默认只计算覆盖率，需要逐j组合的状态时传入 Full
     CoverageResult validateSolution(
         const std::vector<std::vector<int>>& groups,
         const std::vector<int>& samples,
         int j,
-        int s
+        int s,
+        CoverageDetail detail = CoverageDetail::RatioOnly
     ) const;
 
     // 准备解决方案
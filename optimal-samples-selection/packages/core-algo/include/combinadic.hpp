@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "types.hpp"
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 组合数系统（combinadic）：组合与其在字典序中的下标之间的双向映射
+// 字典序与 CombinationGenerator::generate() 的输出顺序一致
+
+// 二项式系数表支持的最大 n
+constexpr int MAX_COMBINADIC_N = 64;
+
+struct BinomialTable {
+    size_t values[MAX_COMBINADIC_N + 1][MAX_COMBINADIC_N + 1];
+};
+
+// 编译期构建二项式系数表（帕斯卡三角）
+constexpr BinomialTable makeBinomialTable() {
+    BinomialTable table{};
+    for (int n = 0; n <= MAX_COMBINADIC_N; ++n) {
+        table.values[n][0] = 1;
+        for (int r = 1; r <= n; ++r) {
+            table.values[n][r] = table.values[n - 1][r - 1] + (r < n ? table.values[n - 1][r] : 0);
+        }
+    }
+    return table;
+}
+
+inline constexpr BinomialTable BINOMIAL_TABLE = makeBinomialTable();
+
+// C(n, r)，越界时返回0
+constexpr size_t binomial(int n, int r) {
+    if (n < 0 || r < 0 || r > n || n > MAX_COMBINADIC_N) return 0;
+    return BINOMIAL_TABLE.values[n][r];
+}
+
+// 计算升序索引组合（取值范围 [0, n)）的字典序下标
+inline size_t combinadicRank(const int* indices, int r, int n) {
+    // 字典序下标 = C(n, r) - 1 - Σ C(n-1-c_i, r-i)
+    size_t colex = 0;
+    for (int i = 0; i < r; ++i) {
+        colex += binomial(n - 1 - indices[i], r - i);
+    }
+    return binomial(n, r) - 1 - colex;
+}
+
+// 由字典序下标还原升序索引组合，结果写入 indices[0..r)
+inline void combinadicUnrank(size_t index, int n, int r, int* indices) {
+    int v = 0;
+    for (int i = 0; i < r; ++i) {
+        while (true) {
+            size_t count = binomial(n - 1 - v, r - 1 - i);
+            if (index < count) break;
+            index -= count;
+            ++v;
+        }
+        indices[i] = v++;
+    }
+}
+
+// 以样本集合为基的位掩码排序器：掩码 <-> 该掩码在 generate(samples, r) 中的下标
+class CombinadicRanker {
+public:
+    explicit CombinadicRanker(const std::vector<int>& samples)
+        : m_n(static_cast<int>(samples.size())), m_ascending(true)
+    {
+        if (m_n > MAX_COMBINADIC_N) {
+            throw AlgorithmError("样本数量超出组合数系统支持范围");
+        }
+        std::fill(std::begin(m_position), std::end(m_position), -1);
+        for (int i = 0; i < m_n; ++i) {
+            m_bits[i] = elementBit(samples[i]);
+            m_position[samples[i]] = i;
+            if (i > 0 && samples[i] < samples[i - 1]) {
+                m_ascending = false;
+            }
+        }
+    }
+
+    int size() const { return m_n; }
+
+    // 大小为 r 的组合总数
+    size_t count(int r) const { return binomial(m_n, r); }
+
+    size_t rank(CombinationMask mask) const {
+        int indices[MAX_COMBINADIC_N];
+        int r = 0;
+        for (; mask; mask &= mask - 1) {
+            int pos = m_position[__builtin_ctzll(mask)];
+            if (pos < 0) {
+                throw AlgorithmError("组合包含不在样本集合中的元素");
+            }
+            indices[r++] = pos;
+        }
+        // 样本升序时位序即下标序，无需排序
+        if (!m_ascending) {
+            std::sort(indices, indices + r);
+        }
+        return combinadicRank(indices, r, m_n);
+    }
+
+    CombinationMask unrank(size_t index, int r) const {
+        int indices[MAX_COMBINADIC_N];
+        combinadicUnrank(index, m_n, r, indices);
+        CombinationMask mask = 0;
+        for (int i = 0; i < r; ++i) {
+            mask |= m_bits[indices[i]];
+        }
+        return mask;
+    }
+
+private:
+    int m_n;
+    bool m_ascending;
+    int m_position[MAX_MASK_VALUE + 1];        // 样本值 -> 在样本集合中的位置
+    CombinationMask m_bits[MAX_COMBINADIC_N];  // 位置 -> 样本位
+};
+
+// 构建 j组 <-> s子集 的稠密双向映射，两侧均以组合数下标索引
+// sToJRanks 中的j下标按升序排列，与按 generate() 顺序遍历j组时的插入顺序一致
+inline void buildRankAdjacency(
+    const CombinadicRanker& ranker,
+    int j,
+    int s,
+    std::vector<std::vector<size_t>>& jToSRanks,
+    std::vector<std::vector<size_t>>& sToJRanks
+) {
+    const size_t jCount = ranker.count(j);
+    jToSRanks.assign(jCount, {});
+    sToJRanks.assign(ranker.count(s), {});
+
+    for (size_t jRank = 0; jRank < jCount; ++jRank) {
+        auto& sRanks = jToSRanks[jRank];
+        sRanks.reserve(binomial(j, s));
+        forEachSubmaskOfSize(ranker.unrank(jRank, j), s, [&](CombinationMask sMask) {
+            size_t sRank = ranker.rank(sMask);
+            sRanks.push_back(sRank);
+            sToJRanks[sRank].push_back(jRank);
+            return true;
+        });
+    }
+}
+
+} // namespace core_algo
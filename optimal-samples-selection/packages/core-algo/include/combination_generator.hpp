@@ -2,7 +2,11 @@
 
 #include <vector>
 #include <memory>
+#include <random>
 #include "types.hpp"
+#include "combination_mask.hpp"
+#include "generation_cache.hpp"
+#include "combination_visitor.hpp"
 
 namespace core_algo {
 
@@ -23,6 +27,43 @@ public:
         int r
     ) const = 0;
     
+    // 生成所有r-元组合的位掩码表示（以样本值为位下标）
+    virtual std::vector<CombinationMask> generateMasks(
+        const std::vector<int>& samples,
+        int r
+    ) const = 0;
+    
+    // 生成所有r-元组合的扁平存储形式（单一连续缓冲区，步长为 r）
+    virtual FlatCombinations generateFlat(
+        const std::vector<int>& elements,
+        int r
+    ) const = 0;
+    
+    // 按旋转门顺序生成所有r-元组合：相邻组合恰好交换一个元素
+    // swaps 非空时写出 C(n,r)-1 个交换，第 i 个描述第 i 个组合到第 i+1 个组合的变化
+    virtual std::vector<std::vector<int>> generateRevolvingDoor(
+        const std::vector<int>& elements,
+        int r,
+        std::vector<CombinationSwap>* swaps = nullptr
+    ) const = 0;
+    
+    // 均匀随机抽取一个r-元位置组合（升序，取值范围 [0, n)），期望 O(r)
+    virtual std::vector<int> sampleUniform(
+        size_t n,
+        size_t r,
+        std::mt19937& rng
+    ) const = 0;
+    
+    // 从 elements 中批量均匀抽取 count 个r-元组合（可重复）。
+    // 随机数取自编号为 stream 的流，其种子由 Config::randomSeed 与 stream 派生，
+    // 与调用线程无关；并行抽样时按块下标等稳定编号指定 stream 即可复现结果
+    virtual std::vector<std::vector<int>> sampleMany(
+        const std::vector<int>& elements,
+        int r,
+        size_t count,
+        size_t stream = 0
+    ) const = 0;
+    
     // 获取迭代器（延迟生成）
     virtual std::unique_ptr<Iterator> getIterator(
         const std::vector<int>& elements,
@@ -35,6 +76,32 @@ public:
         size_t r
     ) const = 0;
     
+    // 组合数系统（combinadic）：组合在 generate() 字典序中的下标
+    // 索引版本：indices 为升序位置组合，取值范围 [0, n)
+    virtual size_t rank(
+        const std::vector<int>& indices,
+        size_t n
+    ) const = 0;
+    
+    // 由下标还原升序位置组合
+    virtual std::vector<int> unrank(
+        size_t index,
+        size_t n,
+        size_t r
+    ) const = 0;
+    
+    // 掩码版本：下标相对于 generate(samples, r) 的输出顺序
+    virtual size_t rankMask(
+        CombinationMask mask,
+        const std::vector<int>& samples
+    ) const = 0;
+    
+    virtual CombinationMask unrankMask(
+        size_t index,
+        const std::vector<int>& samples,
+        size_t r
+    ) const = 0;
+    
     // 并行生成接口
     virtual std::vector<std::vector<int>> generateParallel(
         const std::vector<int>& elements,
@@ -42,6 +109,9 @@ public:
         int threadCount
     ) = 0;
     
+    // 获取组合缓存的命中/未命中/淘汰统计（未启用缓存时全为0）
+    virtual CacheStats getCacheStats() const = 0;
+    
     // 新增：生成j组合及其对应的s子集
     virtual std::pair<std::vector<std::vector<int>>, std::vector<std::vector<std::vector<int>>>> 
     generateJCombinationsAndSSubsets(int m, int n, int j, int s) = 0;
@@ -52,6 +122,12 @@ public:
         int s
     ) const = 0;
 
+    // 为每个j组合生成其s子集，结果为按j组合分组的 CSR 扁平形式
+    virtual FlatCombinations generateFlatSSubsets(
+        const FlatCombinations& j_combinations,
+        int s
+    ) const = 0;
+
     // 生成组合缓存
     virtual CombinationCache generateCombinations(
         const std::vector<int>& samples,
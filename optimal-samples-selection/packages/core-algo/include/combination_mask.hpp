@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+namespace core_algo {
+
+// 组合的位掩码表示：第 v 位为1表示样本值 v 在组合中
+// Config::ParameterRanges 限制 m <= 54，因此任意组合都能放进一个 uint64_t
+using CombinationMask = uint64_t;
+
+// 位掩码可表示的最大样本值
+constexpr int MAX_MASK_VALUE = 63;
+
+// 计算掩码中的元素个数
+inline int maskPopcount(CombinationMask mask) {
+    return __builtin_popcountll(mask);
+}
+
+// 检查 subset 是否为 container 的子集
+inline bool isSubmask(CombinationMask container, CombinationMask subset) {
+    return (container & subset) == subset;
+}
+
+// 单个样本值对应的位
+inline CombinationMask elementBit(int elem) {
+    if (elem < 0 || elem > MAX_MASK_VALUE) {
+        throw AlgorithmError("样本值超出位掩码可表示范围: " + std::to_string(elem));
+    }
+    return CombinationMask(1) << elem;
+}
+
+// 将组合转换为位掩码
+inline CombinationMask toMask(const std::vector<int>& combination) {
+    CombinationMask mask = 0;
+    for (int elem : combination) {
+        mask |= elementBit(elem);
+    }
+    return mask;
+}
+
+// 将位掩码还原为升序排列的组合
+inline std::vector<int> fromMask(CombinationMask mask) {
+    std::vector<int> combination;
+    combination.reserve(maskPopcount(mask));
+    for (; mask; mask &= mask - 1) {
+        combination.push_back(__builtin_ctzll(mask));
+    }
+    return combination;
+}
+
+// 批量转换组合为位掩码
+inline std::vector<CombinationMask> toMasks(const std::vector<std::vector<int>>& combinations) {
+    std::vector<CombinationMask> masks;
+    masks.reserve(combinations.size());
+    for (const auto& combination : combinations) {
+        masks.push_back(toMask(combination));
+    }
+    return masks;
+}
+
+// 批量转换扁平存储的组合为位掩码
+inline std::vector<CombinationMask> toMasks(const FlatCombinations& combinations) {
+    std::vector<CombinationMask> masks(combinations.size());
+    for (size_t i = 0; i < masks.size(); ++i) {
+        const int* row = combinations[i];
+        CombinationMask mask = 0;
+        for (int t = 0; t < combinations.stride; ++t) {
+            mask |= elementBit(row[t]);
+        }
+        masks[i] = mask;
+    }
+    return masks;
+}
+
+// 按字典序枚举 mask 中所有大小为 size 的子掩码，fn 返回 false 时提前停止
+// 返回值表示是否完整枚举（未被提前停止）
+template <typename Fn>
+inline bool forEachSubmaskOfSize(CombinationMask mask, int size, Fn&& fn) {
+    int bits[64];
+    int count = 0;
+    for (CombinationMask rest = mask; rest; rest &= rest - 1) {
+        bits[count++] = __builtin_ctzll(rest);
+    }
+    if (size < 0 || size > count) return true;
+    if (size == 0) return fn(CombinationMask(0));
+
+    int indices[64];
+    for (int i = 0; i < size; ++i) {
+        indices[i] = i;
+    }
+
+    while (true) {
+        CombinationMask sub = 0;
+        for (int i = 0; i < size; ++i) {
+            sub |= CombinationMask(1) << bits[indices[i]];
+        }
+        if (!fn(sub)) return false;
+
+        // 生成下一个索引组合
+        int i = size - 1;
+        while (i >= 0 && indices[i] == count - size + i) {
+            --i;
+        }
+        if (i < 0) return true;
+        ++indices[i];
+        for (int t = i + 1; t < size; ++t) {
+            indices[t] = indices[t - 1] + 1;
+        }
+    }
+}
+
+// 按字典序枚举 universe 中所有包含 base 且大小为 size 的超掩码：
+// 以 base 为基础，追加其余元素的 (size - |base|) 元组合；fn 返回 false 时提前停止
+// 返回值表示是否完整枚举（未被提前停止）
+template <typename Fn>
+inline bool forEachSupermaskOfSize(CombinationMask base, CombinationMask universe, int size, Fn&& fn) {
+    if (!isSubmask(universe, base)) return true;
+    const int extra = size - maskPopcount(base);
+    if (extra < 0) return true;
+    return forEachSubmaskOfSize(universe & ~base, extra, [&](CombinationMask rest) {
+        return fn(base | rest);
+    });
+}
+
+} // namespace core_algo
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 组合的只读视图：指向枚举过程内部的缓冲区，仅在回调期间有效
+struct CombinationView {
+    const int* data;
+    int size;
+
+    const int* begin() const { return data; }
+    const int* end() const { return data + size; }
+    int operator[](int i) const { return data[i]; }
+
+    std::vector<int> toVector() const { return std::vector<int>(begin(), end()); }
+};
+
+namespace detail {
+    // 调用回调：返回 void 的回调视为始终继续
+    template <typename Fn, typename... Args>
+    inline bool invokeVisitor(Fn& fn, Args&&... args) {
+        if constexpr (std::is_void_v<std::invoke_result_t<Fn&, Args...>>) {
+            fn(std::forward<Args>(args)...);
+            return true;
+        } else {
+            return static_cast<bool>(fn(std::forward<Args>(args)...));
+        }
+    }
+
+    // 按字典序枚举 [0, n) 的所有r-元索引组合，visit(const int* indices) 返回 false 时停止
+    template <typename Visit>
+    inline bool forEachIndexCombination(int n, int r, Visit&& visit) {
+        if (r <= 0 || r > n || r > MAX_MASK_VALUE + 1) return true;
+
+        int indices[MAX_MASK_VALUE + 1];
+        for (int i = 0; i < r; ++i) {
+            indices[i] = i;
+        }
+
+        while (true) {
+            if (!visit(static_cast<const int*>(indices))) return false;
+
+            // 生成下一个索引组合
+            int i = r - 1;
+            while (i >= 0 && indices[i] == n - (r - i)) {
+                --i;
+            }
+            if (i < 0) return true;
+            ++indices[i];
+            for (int t = i + 1; t < r; ++t) {
+                indices[t] = indices[t - 1] + 1;
+            }
+        }
+    }
+} // namespace detail
+
+// 按 generate() 的字典序逐个访问 elements[0..n) 的r-元组合，不分配堆内存
+// fn(CombinationView) 返回 false 时提前停止；返回值表示是否完整枚举
+template <typename Fn>
+inline bool forEachCombination(const int* elements, int n, int r, Fn&& fn) {
+    int buffer[MAX_MASK_VALUE + 1];
+    return detail::forEachIndexCombination(n, r, [&](const int* indices) {
+        for (int i = 0; i < r; ++i) {
+            buffer[i] = elements[indices[i]];
+        }
+        return detail::invokeVisitor(fn, CombinationView{buffer, r});
+    });
+}
+
+template <typename Fn>
+inline bool forEachCombination(const std::vector<int>& elements, int r, Fn&& fn) {
+    return forEachCombination(elements.data(), static_cast<int>(elements.size()), r, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+inline bool forEachCombination(CombinationView elements, int r, Fn&& fn) {
+    return forEachCombination(elements.data, elements.size, r, std::forward<Fn>(fn));
+}
+
+// 位掩码版本：fn(CombinationMask) 接收以样本值为位下标的掩码
+template <typename Fn>
+inline bool forEachCombinationMask(const std::vector<int>& samples, int r, Fn&& fn) {
+    CombinationMask bits[MAX_MASK_VALUE + 1];
+    const int n = static_cast<int>(samples.size());
+    if (n > MAX_MASK_VALUE + 1) {
+        throw AlgorithmError("样本数量超出位掩码可表示范围");
+    }
+    if (r <= 0 || r > n) return true;
+    for (int i = 0; i < n; ++i) {
+        bits[i] = elementBit(samples[i]);
+    }
+    return detail::forEachIndexCombination(n, r, [&](const int* indices) {
+        CombinationMask mask = 0;
+        for (int i = 0; i < r; ++i) {
+            mask |= bits[indices[i]];
+        }
+        return detail::invokeVisitor(fn, mask);
+    });
+}
+
+// 旋转门顺序中相邻两个组合之间的元素交换
+struct CombinationSwap {
+    int removed;  // 被换出的元素
+    int added;    // 被换入的元素
+};
+
+// 旋转门（revolving-door）顺序枚举：相邻组合恰好交换一个元素（Knuth 算法 7.2.1.3R）
+// fn(CombinationView, const CombinationSwap*) 中 swap 描述与上一个组合的差异，首个组合为空指针
+// 组合内元素仍按位置升序排列；fn 返回 false 时提前停止，返回值表示是否完整枚举
+template <typename Fn>
+inline bool forEachCombinationRevolvingDoor(const std::vector<int>& elements, int r, Fn&& fn) {
+    const int n = static_cast<int>(elements.size());
+    if (r <= 0 || r > n || n > MAX_MASK_VALUE + 1) return true;
+
+    // c[1..r] 为升序位置，c[r+1] = n 作为哨兵
+    int c[MAX_MASK_VALUE + 3];
+    for (int i = 1; i <= r; ++i) {
+        c[i] = i - 1;
+    }
+    c[r + 1] = n;
+
+    int buffer[MAX_MASK_VALUE + 1];
+    uint64_t previous = 0;
+    bool first = true;
+
+    while (true) {
+        // 访问当前组合，并由位置集合的差异得出交换的元素
+        uint64_t current = 0;
+        for (int i = 1; i <= r; ++i) {
+            buffer[i - 1] = elements[c[i]];
+            current |= uint64_t(1) << c[i];
+        }
+        CombinationSwap swap{};
+        if (!first) {
+            swap.removed = elements[__builtin_ctzll(previous & ~current)];
+            swap.added = elements[__builtin_ctzll(current & ~previous)];
+        }
+        if (!detail::invokeVisitor(fn, CombinationView{buffer, r}, first ? nullptr : &swap)) {
+            return false;
+        }
+        previous = current;
+        first = false;
+
+        // 简单情况：只移动 c[1]
+        int j;
+        bool increase;
+        if (r % 2 == 1) {
+            if (c[1] + 1 < c[2]) {
+                ++c[1];
+                continue;
+            }
+            j = 2;
+            increase = false;
+        } else {
+            if (c[1] > 0) {
+                --c[1];
+                continue;
+            }
+            j = 2;
+            increase = true;
+        }
+
+        bool advanced = false;
+        while (j <= r) {
+            if (!increase) {
+                // 尝试减小 c[j]
+                if (c[j] >= j) {
+                    c[j] = c[j - 1];
+                    c[j - 1] = j - 2;
+                    advanced = true;
+                    break;
+                }
+                ++j;
+            }
+            // 尝试增大 c[j]
+            if (j <= r && c[j] + 1 < c[j + 1]) {
+                c[j - 1] = c[j];
+                ++c[j];
+                advanced = true;
+                break;
+            }
+            ++j;
+            increase = false;
+        }
+        if (!advanced) return true;
+    }
+}
+
+} // namespace core_algo
@@ -3,10 +3,13 @@
 #include <vector>
 #include <memory>
 #include "types.hpp"
+#include "combination_mask.hpp"
 
 namespace core_algo {
 
 // 覆盖计算器接口
+// 计算覆盖率的各方法可通过 detail 选择结果的详细程度：只需要覆盖率的调用方（如求解器的最后一步）
+// 使用 RatioOnly 时不分配逐j组合的状态与计数数组
 class CoverageCalculator {
 public:
     virtual ~CoverageCalculator() = default;
@@ -17,7 +20,91 @@ public:
         const std::vector<std::vector<int>>& j_combinations,    // 所有的j组合
         const std::vector<std::vector<std::vector<int>>>& s_subsets,  // 每个j组合的s子集集合
         CoverageMode mode,                                      // 覆盖模式
-        int min_coverage_count = 1                             // Mode B中使用，表示每个j中最少需要多少个s被覆盖
+        int min_coverage_count = 1,                            // Mode B中使用，表示每个j中最少需要多少个s被覆盖
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
+    ) const = 0;
+
+    // 计算覆盖率（位掩码版本）：每个j组合的s子集直接由其掩码枚举，无需传入s子集集合
+    virtual CoverageResult calculateCoverage(
+        const std::vector<CombinationMask>& k_groups,           // 选中的k元组掩码
+        const std::vector<CombinationMask>& j_combinations,     // 所有的j组合掩码
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1,                            // Mode B中使用
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
+    ) const = 0;
+
+    // 验证模式（位掩码版本）：先把全部k组的s子集标记到被覆盖s子集表中，再逐个探测每个j组合的 C(j, s) 个s子集
+    // 代价为 |K|·C(k, s) + |J|·C(j, s)，没有逐k组的内层循环，适合k组很多的完整解验证
+    // 结果与 calculateCoverage 一致；表超出 Config::maxCacheBytes 时回退到 calculateCoverage
+    virtual CoverageResult verifyCoverage(
+        const std::vector<CombinationMask>& k_groups,           // 选中的k元组掩码
+        const std::vector<CombinationMask>& j_combinations,     // 所有的j组合掩码
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1,                            // Mode B中使用
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
+    ) const = 0;
+
+    // 可行性检查：是否所有j组合都满足覆盖要求，不生成 CoverageResult
+    // 工作线程发现未覆盖的j组合后通过原子标志互相取消，剩余的j组合不再检查
+    virtual bool isFeasible(
+        const std::vector<CombinationMask>& k_groups,           // 选中的k元组掩码
+        const std::vector<CombinationMask>& j_combinations,     // 所有的j组合掩码
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1                             // Mode B中使用
+    ) const = 0;
+
+    // 下标最小的未满足覆盖要求的j组合，全部满足时返回 -1；提前退出方式同 isFeasible
+    virtual int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,           // 选中的k元组掩码
+        const std::vector<CombinationMask>& j_combinations,     // 所有的j组合掩码
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1                             // Mode B中使用
+    ) const = 0;
+
+    // 批量评估：第 c 个候选解为 base_solution 加上 candidate_groups[c]，返回各候选相对于基准解的覆盖变化
+    // 基准解的覆盖状态只计算一次；候选按块并行，每块对j组合只遍历一次
+    virtual std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,      // 基准解的k元组掩码
+        const std::vector<CombinationMask>& candidate_groups,   // 候选k元组掩码
+        const std::vector<CombinationMask>& j_combinations,     // 所有的j组合掩码
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1                             // Mode B中使用
+    ) const = 0;
+
+    // 计算覆盖率（流式版本）：j组合由 samples 按字典序分块并行枚举，不物化j组合与s子集，
+    // 除结果外只使用定长缓冲区；结果顺序与 generate(samples, j) 一致
+    virtual CoverageResult calculateCoverage(
+        const std::vector<std::vector<int>>& k_groups,          // 选中的k元组集合
+        const std::vector<int>& samples,                        // 样本集合
+        int j,                                                  // j组合大小
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1,                            // Mode B中使用
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
+    ) const = 0;
+
+    // Mode A 覆盖率：等价于流式版本的 CoverMinOneS，每个j组与每个k组只做一次交集popcount，无需s子集
+    virtual CoverageResult calculateModeACoverage(
+        const std::vector<std::vector<int>>& k_groups,          // 选中的k元组集合
+        const std::vector<int>& samples,                        // 样本集合
+        int j,                                                  // j组合大小
+        int s,                                                  // s子集大小
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
+    ) const = 0;
+
+    // 计算覆盖率（扁平存储版本）：k组与j组合均为连续缓冲区
+    virtual CoverageResult calculateCoverage(
+        const FlatCombinations& k_groups,                       // 选中的k元组
+        const FlatCombinations& j_combinations,                 // 所有的j组合
+        int s,                                                  // s子集大小
+        CoverageMode mode,                                      // 覆盖模式
+        int min_coverage_count = 1,                            // Mode B中使用
+        CoverageDetail detail = CoverageDetail::Full            // 结果的详细程度
     ) const = 0;
 
     // 工厂方法
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 批量 Mode A 覆盖内核
+// 判断 j 组是否被覆盖只需对每个 k 组做一次 按位与 + popcount + 比较，是典型的数据并行问题：
+// 每个 k 掩码广播到向量寄存器后，与一批 j 掩码同时比较（SSE4.2 每条指令 2 个、AVX2 4 个、AVX-512 8 个），
+// 一批 j 组全部被覆盖时即停止扫描剩余 k 组
+
+// 指令集级别，按能力从低到高排列
+enum class SimdLevel {
+    Scalar = 0,
+    SSE42 = 1,
+    AVX2 = 2,
+    AVX512 = 3
+};
+
+// covered[i] = 存在 x 使 popcount(kGroups[x] & jGroups[i]) >= s ? 1 : 0，要求 s > 0
+using ModeACoverageKernel = void (*)(
+    const CombinationMask* jGroups,
+    size_t jCount,
+    const CombinationMask* kGroups,
+    size_t kCount,
+    int s,
+    char* covered
+);
+
+// 通过 CPUID 检测当前处理器支持的最高级别；非 x86 平台与 WebAssembly 构建始终为 Scalar
+SimdLevel detectSimdLevel();
+
+// 不高于 level 的可用内核中最快的一个
+ModeACoverageKernel modeACoverageKernelFor(SimdLevel level);
+
+const char* simdLevelName(SimdLevel level);
+
+} // namespace core_algo
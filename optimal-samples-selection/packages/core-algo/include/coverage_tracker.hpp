@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 增量覆盖跟踪器：维护当前已选k组对全部j组的覆盖状态
+// Mode A 记录每个j组的覆盖者数（满足 |k∩j| >= s 的已选k组数）；
+// Mode B/C 记录每个j组中每个s子集被多少个已选k组包含，以及其中被覆盖的s子集数
+// 添加/移除一个k组只更新与其交集不小于s的j组，查询无需重新计算
+class CoverageTracker {
+public:
+    virtual ~CoverageTracker() = default;
+
+    // 添加一个k组（允许重复添加，按多重集计数）
+    virtual void addGroup(CombinationMask kGroup) = 0;
+
+    // 移除一个已添加的k组；未添加过时抛出 AlgorithmError
+    virtual void removeGroup(CombinationMask kGroup) = 0;
+
+    // 未满足覆盖要求的j组数
+    virtual size_t uncoveredCount() const = 0;
+
+    // 是否所有j组都满足覆盖要求
+    virtual bool isFeasible() const = 0;
+
+    // 添加该k组后新满足覆盖要求的j组数（不修改状态）
+    virtual size_t marginalGain(CombinationMask kGroup) const = 0;
+
+    // 第 i 个j组是否满足覆盖要求
+    virtual bool isCovered(size_t jIndex) const = 0;
+
+    // 第 i 个j组中被覆盖的s子集数（Mode A 为覆盖者数）
+    virtual int coveredCount(size_t jIndex) const = 0;
+
+    virtual size_t jGroupCount() const = 0;
+    virtual size_t groupCount() const = 0;
+
+    void addGroup(const std::vector<int>& kGroup) { addGroup(toMask(kGroup)); }
+    void removeGroup(const std::vector<int>& kGroup) { removeGroup(toMask(kGroup)); }
+    size_t marginalGain(const std::vector<int>& kGroup) const { return marginalGain(toMask(kGroup)); }
+
+    // 工厂方法：j组为 samples 的全部j元组合（与 generateMasks(samples, j) 顺序一致）
+    static std::unique_ptr<CoverageTracker> create(
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        CoverageMode mode,
+        int minCoverageCount = 1
+    );
+
+    // 工厂方法：使用给定的j组掩码
+    static std::unique_ptr<CoverageTracker> create(
+        std::vector<CombinationMask> jGroups,
+        int s,
+        CoverageMode mode,
+        int minCoverageCount = 1
+    );
+};
+
+} // namespace core_algo
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "types.hpp"
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 被覆盖s子集表：把一组k组的全部s子集标记在一张位图中，之后任一s子集是否被覆盖只需一次位测试
+// 样本值先压缩到全集（universe）内的局部位置：
+// - 全集大小 n <= DIRECT_MAX_BITS 时位图按局部子集掩码直接寻址，共 2^n 位（n = 25 时 4MB）
+// - 否则按局部位置的组合数下标寻址，共 C(n, s) 位
+// 构建代价为 |K|·C(k, s)，每个j组的查询代价为 C(j, s)，与k组数量无关
+class CoveredSubsetTable {
+public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr int DIRECT_MAX_BITS = 25;
+
+    CoveredSubsetTable() = default;
+
+    // 标记 kGroups 中每个k组落在 universe 内的全部s子集
+    static CoveredSubsetTable build(
+        const std::vector<CombinationMask>& kGroups,
+        CombinationMask universe,
+        int s
+    );
+
+    // 全集大小为 universeSize 时位图的字节数
+    static size_t estimateBytes(int universeSize, int s);
+
+    int universeSize() const { return m_n; }
+    bool directAddressed() const { return m_direct; }
+    size_t byteCount() const { return m_bits.size() * sizeof(Word); }
+
+    // subset（大小为 s，且包含于全集）是否被某个k组包含
+    bool contains(CombinationMask subset) const {
+        return test(index(compress(subset)));
+    }
+
+    // 按字典序依次以 fn(是否被覆盖) 访问 jGroup 的全部s子集，fn 返回 false 时提前停止
+    // 返回值表示是否完整枚举（未被提前停止）
+    template <typename Fn>
+    bool forEachSubsetStatus(CombinationMask jGroup, Fn&& fn) const {
+        // 局部掩码的子掩码即s子集的局部掩码，压缩只需对j组做一次
+        return forEachSubmaskOfSize(compress(jGroup), m_s, [&](CombinationMask local) {
+            return fn(test(index(local)));
+        });
+    }
+
+private:
+    int m_n = 0;
+    int m_s = 0;
+    bool m_direct = true;
+    CombinationMask m_universe = 0;
+    int m_position[MAX_MASK_VALUE + 1] = {};  // 样本值 -> 全集内的局部位置
+    std::vector<Word> m_bits;
+
+    // 样本掩码 -> 局部掩码，全集之外的元素被丢弃
+    CombinationMask compress(CombinationMask mask) const {
+        CombinationMask local = 0;
+        for (mask &= m_universe; mask; mask &= mask - 1) {
+            local |= CombinationMask(1) << m_position[__builtin_ctzll(mask)];
+        }
+        return local;
+    }
+
+    size_t index(CombinationMask local) const {
+        return m_direct ? static_cast<size_t>(local) : rank(local);
+    }
+
+    // 局部掩码在 C(n, s) 中的字典序下标
+    size_t rank(CombinationMask local) const;
+
+    bool test(size_t bit) const {
+        return (m_bits[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+    }
+};
+
+} // namespace core_algo
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+
+namespace core_algo {
+
+// 缓存统计信息
+struct CacheStats {
+    size_t hits = 0;        // 命中次数
+    size_t misses = 0;      // 未命中次数
+    size_t evictions = 0;   // 淘汰次数
+    size_t entries = 0;     // 当前条目数
+    size_t bytes = 0;       // 当前占用字节数（估算）
+};
+
+// 组合生成结果缓存：以 (元素内容, r) 为键，按 LRU 淘汰，受条目数与字节预算双重限制
+// 所有操作均加锁，可在并发求解之间共享
+class GenerationCache {
+public:
+    using Combinations = std::vector<std::vector<int>>;
+    using Value = std::shared_ptr<const Combinations>;
+
+    virtual ~GenerationCache() = default;
+
+    // 查找缓存，未命中时返回空指针
+    virtual Value find(const std::vector<int>& elements, int r) = 0;
+
+    // 插入缓存；单个结果超出字节预算时不缓存
+    virtual void insert(const std::vector<int>& elements, int r, Value value) = 0;
+
+    virtual CacheStats stats() const = 0;
+    virtual void clear() = 0;
+
+    // 工厂方法：创建独立的缓存
+    static std::shared_ptr<GenerationCache> create(size_t maxEntries, size_t maxBytes);
+
+    // 获取进程内共享的缓存，限制相同的调用方得到同一实例
+    static std::shared_ptr<GenerationCache> shared(size_t maxEntries, size_t maxBytes);
+};
+
+} // namespace core_algo
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "combination_mask.hpp"
+#include "incidence_matrix.hpp"
+
+namespace core_algo {
+
+// 惰性贪心（CELF）集合覆盖：k组 groupMasks 覆盖 j组 jMasks，k组覆盖j组当且仅当 |k∩j| >= s
+// 返回选中k组的下标（按选中顺序），全部覆盖时已去掉冗余的k组；无法覆盖全部j组时返回已选部分
+// incidence 为 IncidenceMatrix::forCoverage 构建的 k组 × j组关联矩阵，为空时逐对计算交集
+std::vector<size_t> lazyGreedyCover(
+    const IncidenceMatrix& incidence,
+    const std::vector<CombinationMask>& groupMasks,
+    const std::vector<CombinationMask>& jMasks,
+    int s
+);
+
+} // namespace core_algo
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "types.hpp"
+#include "combination_mask.hpp"
+
+namespace core_algo {
+
+// 行组合 × 列组合的关联矩阵（如 k组 × j组、s子集 × j组），以64位字按位压缩存储
+// 行视图：每行一个位集，第 c 位表示该行满足第 c 列；列视图为其转置
+// 对给定参数只需构建一次，选择与验证过程中的"是否满足"查询均为一次位测试
+class IncidenceMatrix {
+public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    IncidenceMatrix() = default;
+
+    // 行 r 满足列 c 当且仅当 |rows[r] & columns[c]| >= minIntersection；按行分块并行构建
+    static IncidenceMatrix build(
+        const std::vector<CombinationMask>& rows,
+        const std::vector<CombinationMask>& columns,
+        int minIntersection,
+        int threadCount = 0  // 0 表示按硬件并发数
+    );
+
+    // 单个k组满足j组的条件（覆盖模式的逐组判定），按交集大小阈值构建
+    static IncidenceMatrix forCoverage(
+        const std::vector<CombinationMask>& kGroups,
+        const std::vector<CombinationMask>& jGroups,
+        int j,
+        int s,
+        CoverageMode mode,
+        int minCoverageCount = 1,
+        int threadCount = 0
+    );
+
+    // 由稀疏邻接表（行 -> 列下标）构建
+    static IncidenceMatrix fromAdjacency(
+        const std::vector<std::vector<size_t>>& adjacency,
+        size_t columnCount
+    );
+
+    // 单个k组满足j组所需的最小交集大小：
+    // Mode A 需要至少一个s子集，即 |k∩j| >= s；Mode B 需要 C(|k∩j|, s) >= N；Mode C 需要 j ⊆ k
+    // 任何交集都不满足时返回 j + 1
+    static int requiredIntersection(int j, int s, CoverageMode mode, int minCoverageCount = 1);
+
+    // 行视图与列视图合计的字节数
+    static size_t estimateBytes(size_t rowCount, size_t columnCount);
+
+    size_t rowCount() const { return m_rowCount; }
+    size_t columnCount() const { return m_columnCount; }
+    size_t wordsPerRow() const { return m_wordsPerRow; }
+    size_t wordsPerColumn() const { return m_wordsPerColumn; }
+    bool empty() const { return m_rowCount == 0 || m_columnCount == 0; }
+
+    bool covers(size_t row, size_t column) const {
+        return (m_rows[row * m_wordsPerRow + column / WORD_BITS] >> (column % WORD_BITS)) & 1;
+    }
+
+    // 第 r 行的位集（长度 wordsPerRow()）
+    const Word* row(size_t r) const { return m_rows.data() + r * m_wordsPerRow; }
+
+    // 第 c 列的位集（长度 wordsPerColumn()），即满足该列的所有行
+    const Word* column(size_t c) const { return m_columns.data() + c * m_wordsPerColumn; }
+
+    // 该行满足的列数 / 满足该列的行数
+    size_t rowDegree(size_t r) const;
+    size_t columnDegree(size_t c) const;
+
+    // 第 r 行中不在 covered 位集（长度 wordsPerRow()）中的列数
+    size_t countUncovered(size_t r, const Word* covered) const;
+
+    // 把第 r 行合并到 covered 位集中
+    void mergeRow(size_t r, Word* covered) const;
+
+    // 给定行集合满足的所有列
+    std::vector<Word> coveredColumns(const std::vector<size_t>& rows) const;
+
+private:
+    size_t m_rowCount = 0;
+    size_t m_columnCount = 0;
+    size_t m_wordsPerRow = 0;
+    size_t m_wordsPerColumn = 0;
+    std::vector<Word> m_rows;     // 行主序：m_rows[r * wordsPerRow + w]
+    std::vector<Word> m_columns;  // 转置：m_columns[c * wordsPerColumn + w]
+
+    void allocate(size_t rowCount, size_t columnCount);
+    void buildColumns(int threadCount);
+};
+
+} // namespace core_algo
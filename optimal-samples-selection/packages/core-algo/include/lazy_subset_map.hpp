@@ -0,0 +1,76 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core_algo {
+
+// 组合到组合列表的映射（如 s子集 -> 包含它的j组）
+using SubsetMap = std::map<std::vector<int>, std::vector<std::vector<int>>>;
+
+// 延迟构建的映射：首次访问时才调用构建函数，之后复用结果
+// 热点路径使用按组合数下标索引的稠密映射，此类仅为需要按向量查找的调用方保留兼容接口
+// 拷贝共享同一份状态；构建过程加锁，可从多个线程安全访问
+class LazySubsetMap {
+public:
+    using Builder = std::function<SubsetMap()>;
+
+    LazySubsetMap() : m_state(std::make_shared<State>()) {}
+
+    // 直接使用已构建的映射
+    LazySubsetMap& operator=(const SubsetMap& map) {
+        m_state = std::make_shared<State>();
+        m_state->map = map;
+        m_state->built = true;
+        return *this;
+    }
+
+    // 设置构建函数，映射在首次访问时构建
+    void setBuilder(Builder builder) {
+        m_state = std::make_shared<State>();
+        m_state->builder = std::move(builder);
+    }
+
+    bool isBuilt() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->built;
+    }
+
+    const SubsetMap& get() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->built) {
+            if (m_state->builder) {
+                m_state->map = m_state->builder();
+                m_state->builder = nullptr;
+            }
+            m_state->built = true;
+        }
+        return m_state->map;
+    }
+
+    operator const SubsetMap&() const { return get(); }
+
+    // 与 std::map 一致的只读接口
+    SubsetMap::const_iterator find(const std::vector<int>& key) const { return get().find(key); }
+    SubsetMap::const_iterator begin() const { return get().begin(); }
+    SubsetMap::const_iterator end() const { return get().end(); }
+    const std::vector<std::vector<int>>& at(const std::vector<int>& key) const { return get().at(key); }
+    size_t count(const std::vector<int>& key) const { return get().count(key); }
+    size_t size() const { return get().size(); }
+    bool empty() const { return get().empty(); }
+
+private:
+    struct State {
+        std::mutex mutex;
+        bool built = false;
+        Builder builder;
+        SubsetMap map;
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace core_algo
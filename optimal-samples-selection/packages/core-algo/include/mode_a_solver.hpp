@@ -49,4 +49,23 @@ std::shared_ptr<ModeASolver> createModeASolver(
     const Config& config
 );
 
+// 惰性贪心（CELF）求解器：按边际j组覆盖增益逐个选择k组，只重新计算堆顶的增益
+// 速度快但不保证组数最少，可作为精确求解的初始上界
+std::shared_ptr<ModeASolver> createGreedyModeASolver(
+    std::shared_ptr<CombinationGenerator> combGen,
+    std::shared_ptr<SetOperations> setOps,
+    std::shared_ptr<CoverageCalculator> covCalc,
+    const Config& config
+);
+
+// 分支定界精确求解器：在k组 × j组的位集关联矩阵上搜索组数最少的覆盖，以贪心解为初始上界
+// 完整搜索后 isOptimal 为 true；超出 Config::timeLimit 时返回 Status::Timeout、当前最好解及与下界的差距
+// 关联矩阵超出 Config::maxCacheBytes 时返回 Status::Error，适用于 n <= 12~14 的实例
+std::shared_ptr<ModeASolver> createExactModeASolver(
+    std::shared_ptr<CombinationGenerator> combGen,
+    std::shared_ptr<SetOperations> setOps,
+    std::shared_ptr<CoverageCalculator> covCalc,
+    const Config& config
+);
+
 } // namespace core_algo 
\ No newline at end of file
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "combination_mask.hpp"
+#include "combinadic.hpp"
+
+namespace core_algo {
+
+// 针对参数网格（k, j, s <= 7）的编译期特化内核
+// 组合大小在编译期确定后，内层循环使用定长数组并可被完全展开；
+// 运行期通过分派表选择对应的实例，超出网格范围时返回空指针，由调用方回退到通用实现
+// k组与j组的生成使用按组合大小 R 特化的枚举内核，s子集展开与覆盖计数使用按 (J, S) 特化的内核
+
+// 内核支持的最大组合大小
+constexpr int MAX_KERNEL_SIZE = 7;
+
+// J元集合的全部S元子集在字典序下的局部位置表
+template <int J, int S>
+struct SubsetIndexTable {
+    static constexpr int COUNT = static_cast<int>(binomial(J, S));
+    int indices[COUNT][S];
+};
+
+template <int J, int S>
+constexpr SubsetIndexTable<J, S> makeSubsetIndexTable() {
+    SubsetIndexTable<J, S> table{};
+    int current[S] = {};
+    for (int i = 0; i < S; ++i) {
+        current[i] = i;
+    }
+    for (int c = 0; c < SubsetIndexTable<J, S>::COUNT; ++c) {
+        for (int i = 0; i < S; ++i) {
+            table.indices[c][i] = current[i];
+        }
+        // 生成下一个索引组合
+        int i = S - 1;
+        while (i >= 0 && current[i] == J - S + i) {
+            --i;
+        }
+        if (i < 0) break;
+        ++current[i];
+        for (int t = i + 1; t < S; ++t) {
+            current[t] = current[t - 1] + 1;
+        }
+    }
+    return table;
+}
+
+template <int J, int S>
+inline constexpr SubsetIndexTable<J, S> SUBSET_INDEX_TABLE = makeSubsetIndexTable<J, S>();
+
+// J元集合的局部掩码（第 i 位表示第 i 个元素）到其包含的S元局部子集的位集：
+// 第 c 位对应 SUBSET_INDEX_TABLE<J, S> 中字典序第 c 个子集，C(J, S) <= 35 可放入一个64位字
+template <int J, int S>
+struct LocalSubsetTable {
+    uint64_t subsets[1 << J];
+};
+
+template <int J, int S>
+constexpr LocalSubsetTable<J, S> makeLocalSubsetTable() {
+    LocalSubsetTable<J, S> table{};
+    constexpr auto indexTable = makeSubsetIndexTable<J, S>();
+    for (int local = 0; local < (1 << J); ++local) {
+        uint64_t bits = 0;
+        for (int c = 0; c < SubsetIndexTable<J, S>::COUNT; ++c) {
+            int subset = 0;
+            for (int i = 0; i < S; ++i) {
+                subset |= 1 << indexTable.indices[c][i];
+            }
+            if ((subset & ~local) == 0) {
+                bits |= uint64_t(1) << c;
+            }
+        }
+        table.subsets[local] = bits;
+    }
+    return table;
+}
+
+template <int J, int S>
+inline constexpr LocalSubsetTable<J, S> LOCAL_SUBSET_TABLE = makeLocalSubsetTable<J, S>();
+
+// 按字典序把 elements[0..n) 的全部R元组合逐行写入 out
+template <int R>
+void enumerateKernel(const int* elements, int n, int* out) {
+    if (n < R) return;
+    int indices[R];
+    for (int i = 0; i < R; ++i) {
+        indices[i] = i;
+    }
+    while (true) {
+        for (int i = 0; i < R; ++i) {
+            *out++ = elements[indices[i]];
+        }
+        int i = R - 1;
+        while (i >= 0 && indices[i] == n - R + i) {
+            --i;
+        }
+        if (i < 0) return;
+        ++indices[i];
+        for (int t = i + 1; t < R; ++t) {
+            indices[t] = indices[t - 1] + 1;
+        }
+    }
+}
+
+// 把一个J元组合的全部S元子集逐行写入 out（共 C(J, S) 行）
+template <int J, int S>
+void subsetKernel(const int* jGroup, int* out) {
+    constexpr const auto& table = SUBSET_INDEX_TABLE<J, S>;
+    for (int c = 0; c < SubsetIndexTable<J, S>::COUNT; ++c) {
+        for (int i = 0; i < S; ++i) {
+            *out++ = jGroup[table.indices[c][i]];
+        }
+    }
+}
+
+// 把J元掩码的全部S元子掩码按字典序写入 out
+template <int J, int S>
+void submaskKernel(CombinationMask jGroup, CombinationMask* out) {
+    constexpr const auto& table = SUBSET_INDEX_TABLE<J, S>;
+    CombinationMask bits[J];
+    for (int i = 0; i < J; ++i) {
+        bits[i] = jGroup & (~jGroup + 1);
+        jGroup &= jGroup - 1;
+    }
+    for (int c = 0; c < SubsetIndexTable<J, S>::COUNT; ++c) {
+        CombinationMask mask = 0;
+        for (int i = 0; i < S; ++i) {
+            mask |= bits[table.indices[c][i]];
+        }
+        out[c] = mask;
+    }
+}
+
+// 统计j组中被任一k组覆盖的s子集数，达到 limit 时提前返回
+template <int J, int S>
+int coverageCountKernel(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount, int limit) {
+    CombinationMask subsets[SubsetIndexTable<J, S>::COUNT];
+    submaskKernel<J, S>(jGroup, subsets);
+    int covered = 0;
+    for (CombinationMask subset : subsets) {
+        for (size_t k = 0; k < kCount; ++k) {
+            if (isSubmask(kGroups[k], subset)) {
+                if (++covered >= limit) return covered;
+                break;
+            }
+        }
+    }
+    return covered;
+}
+
+// 按字典序检查s子集，遇到第一个未被覆盖的s子集即停止；返回此前被覆盖的个数
+template <int J, int S>
+int coveragePrefixKernel(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount, bool& allCovered) {
+    CombinationMask subsets[SubsetIndexTable<J, S>::COUNT];
+    submaskKernel<J, S>(jGroup, subsets);
+    int covered = 0;
+    for (CombinationMask subset : subsets) {
+        bool found = false;
+        for (size_t k = 0; k < kCount; ++k) {
+            if (isSubmask(kGroups[k], subset)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            allCovered = false;
+            return covered;
+        }
+        ++covered;
+    }
+    allCovered = true;
+    return covered;
+}
+
+// j组中被k组并集覆盖的s子集位集（第 c 位对应字典序第 c 个s子集）
+// 每个k组先把 k∩j 压缩为j内的局部掩码，再查表得到其包含的全部s子集；所有s子集都被覆盖时提前返回
+// Mode B 的覆盖数为其popcount，Mode C 的字典序前缀覆盖数为其最低连续1的个数
+template <int J, int S>
+uint64_t coveredSubsetsKernel(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount) {
+    constexpr const auto& table = LOCAL_SUBSET_TABLE<J, S>;
+    constexpr int COUNT = SubsetIndexTable<J, S>::COUNT;
+    constexpr uint64_t ALL = COUNT == 64 ? ~uint64_t(0) : (uint64_t(1) << COUNT) - 1;
+
+    CombinationMask bits[J];
+    for (int i = 0; i < J; ++i) {
+        bits[i] = jGroup & (~jGroup + 1);
+        jGroup &= jGroup - 1;
+    }
+
+    uint64_t covered = 0;
+    for (size_t k = 0; k < kCount; ++k) {
+        int local = 0;
+        for (int i = 0; i < J; ++i) {
+            local |= (kGroups[k] & bits[i]) ? (1 << i) : 0;
+        }
+        covered |= table.subsets[local];
+        if (covered == ALL) break;
+    }
+    return covered;
+}
+
+// 运行期分派
+using EnumerateKernel = void (*)(const int* elements, int n, int* out);
+using SubsetKernel = void (*)(const int* jGroup, int* out);
+using SubmaskKernel = void (*)(CombinationMask jGroup, CombinationMask* out);
+using CoverageCountKernel = int (*)(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount, int limit);
+using CoveragePrefixKernel = int (*)(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount, bool& allCovered);
+using CoveredSubsetsKernel = uint64_t (*)(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount);
+
+namespace detail {
+    constexpr size_t KERNEL_DIM = MAX_KERNEL_SIZE + 1;
+
+    template <size_t R>
+    constexpr EnumerateKernel enumerateEntry() {
+        if constexpr (R == 0) return nullptr;
+        else return &enumerateKernel<static_cast<int>(R)>;
+    }
+
+    template <size_t... R>
+    constexpr std::array<EnumerateKernel, sizeof...(R)> makeEnumerateTable(std::index_sequence<R...>) {
+        return {{enumerateEntry<R>()...}};
+    }
+
+    // 每类 (J, S) 内核的选择器，提供内核类型与取实例的方法
+    struct SubsetSelector {
+        using Kernel = SubsetKernel;
+        template <int J, int S> static constexpr Kernel get() { return &subsetKernel<J, S>; }
+    };
+    struct SubmaskSelector {
+        using Kernel = SubmaskKernel;
+        template <int J, int S> static constexpr Kernel get() { return &submaskKernel<J, S>; }
+    };
+    struct CoverageCountSelector {
+        using Kernel = CoverageCountKernel;
+        template <int J, int S> static constexpr Kernel get() { return &coverageCountKernel<J, S>; }
+    };
+    struct CoveragePrefixSelector {
+        using Kernel = CoveragePrefixKernel;
+        template <int J, int S> static constexpr Kernel get() { return &coveragePrefixKernel<J, S>; }
+    };
+    struct CoveredSubsetsSelector {
+        using Kernel = CoveredSubsetsKernel;
+        template <int J, int S> static constexpr Kernel get() { return &coveredSubsetsKernel<J, S>; }
+    };
+
+    // 仅 1 <= S <= J 的位置有内核
+    template <typename Selector, int J, int S>
+    constexpr typename Selector::Kernel pairEntry() {
+        if constexpr (S >= 1 && S <= J) return Selector::template get<J, S>();
+        else return nullptr;
+    }
+
+    // 二维 (J, S) 表按 J * KERNEL_DIM + S 展平
+    template <typename Selector, size_t... I>
+    constexpr std::array<typename Selector::Kernel, sizeof...(I)> makePairTable(std::index_sequence<I...>) {
+        return {{pairEntry<Selector, static_cast<int>(I / KERNEL_DIM), static_cast<int>(I % KERNEL_DIM)>()...}};
+    }
+
+    using PairIndices = std::make_index_sequence<KERNEL_DIM * KERNEL_DIM>;
+
+    inline constexpr auto ENUMERATE_KERNELS = makeEnumerateTable(std::make_index_sequence<KERNEL_DIM>{});
+    inline constexpr auto SUBSET_KERNELS = makePairTable<SubsetSelector>(PairIndices{});
+    inline constexpr auto SUBMASK_KERNELS = makePairTable<SubmaskSelector>(PairIndices{});
+    inline constexpr auto COVERAGE_COUNT_KERNELS = makePairTable<CoverageCountSelector>(PairIndices{});
+    inline constexpr auto COVERAGE_PREFIX_KERNELS = makePairTable<CoveragePrefixSelector>(PairIndices{});
+    inline constexpr auto COVERED_SUBSETS_KERNELS = makePairTable<CoveredSubsetsSelector>(PairIndices{});
+
+    constexpr bool inPairGrid(int j, int s) {
+        return j >= 1 && j <= MAX_KERNEL_SIZE && s >= 1 && s <= j;
+    }
+
+    constexpr size_t pairIndex(int j, int s) {
+        return static_cast<size_t>(j) * KERNEL_DIM + static_cast<size_t>(s);
+    }
+} // namespace detail
+
+inline EnumerateKernel enumerateKernelFor(int r) {
+    return (r >= 1 && r <= MAX_KERNEL_SIZE) ? detail::ENUMERATE_KERNELS[r] : nullptr;
+}
+
+inline SubsetKernel subsetKernelFor(int j, int s) {
+    return detail::inPairGrid(j, s) ? detail::SUBSET_KERNELS[detail::pairIndex(j, s)] : nullptr;
+}
+
+inline SubmaskKernel submaskKernelFor(int j, int s) {
+    return detail::inPairGrid(j, s) ? detail::SUBMASK_KERNELS[detail::pairIndex(j, s)] : nullptr;
+}
+
+inline CoverageCountKernel coverageCountKernelFor(int j, int s) {
+    return detail::inPairGrid(j, s) ? detail::COVERAGE_COUNT_KERNELS[detail::pairIndex(j, s)] : nullptr;
+}
+
+inline CoveragePrefixKernel coveragePrefixKernelFor(int j, int s) {
+    return detail::inPairGrid(j, s) ? detail::COVERAGE_PREFIX_KERNELS[detail::pairIndex(j, s)] : nullptr;
+}
+
+inline CoveredSubsetsKernel coveredSubsetsKernelFor(int j, int s) {
+    return detail::inPairGrid(j, s) ? detail::COVERED_SUBSETS_KERNELS[detail::pairIndex(j, s)] : nullptr;
+}
+
+} // namespace core_algo
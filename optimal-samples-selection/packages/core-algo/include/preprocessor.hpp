@@ -4,11 +4,13 @@
 #include <map>
 #include <memory>
 #include "types.hpp"  // 为了使用CoverageMode
+#include "lazy_subset_map.hpp"
 
 namespace core_algo {
 
 class CombinationGenerator;
 class SetOperations;
+class CombinadicRanker;
 
 struct PreprocessResult {
     // j组和s子集的基本信息
@@ -16,9 +18,13 @@ struct PreprocessResult {
     std::vector<std::vector<int>> allSSubsets;               // 所有可能的s子集（从n中生成）
     std::vector<std::vector<int>> selectedSSubsets;          // 选出的Top s子集
     
-    // 双向映射关系
-    std::map<std::vector<int>, std::vector<std::vector<int>>> jToSMap;  // j组到其s子集的映射
-    std::map<std::vector<int>, std::vector<std::vector<int>>> sToJMap;  // s子集到包含它的j组的映射
+    // 双向映射关系（首次访问时构建）
+    LazySubsetMap jToSMap;  // j组到其s子集的映射
+    LazySubsetMap sToJMap;  // s子集到包含它的j组的映射
+    
+    // 按组合数下标索引的稠密映射（下标即组合在 generate(samples, r) 中的位置）
+    std::vector<std::vector<size_t>> jToSRanks;              // j组下标 -> 其s子集下标
+    std::vector<std::vector<size_t>> sToJRanks;              // s子集下标 -> 包含它的j组下标
     
     // 覆盖映射信息
     std::map<std::vector<int>, int> jCoverageCount;         // 每个j组被选中的s子集覆盖次数
@@ -27,9 +33,11 @@ struct PreprocessResult {
 
 class Preprocessor {
 public:
+    // config.maxCacheBytes 限制预处理中 s子集 × j组关联矩阵的内存
     Preprocessor(
         std::shared_ptr<CombinationGenerator> combGen,
-        std::shared_ptr<SetOperations> setOps
+        std::shared_ptr<SetOperations> setOps,
+        const Config& config = Config()
     );
 
     PreprocessResult preprocess(
@@ -53,7 +61,8 @@ private:
         virtual ~SelectionStrategy() = default;
         virtual std::vector<std::vector<int>> selectTopS(
             const std::vector<std::vector<int>>& allSSubsets,
-            const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+            const std::vector<std::vector<size_t>>& sToJRanks,
+            const CombinadicRanker& ranker,
             const std::vector<std::vector<int>>& jGroups,
             int n,
             int k
@@ -79,9 +88,12 @@ private:
     // Mode A的选择策略
     class ModeAStrategy : public SelectionStrategy {
     public:
+        explicit ModeAStrategy(size_t maxIncidenceBytes) : m_maxIncidenceBytes(maxIncidenceBytes) {}
+
         std::vector<std::vector<int>> selectTopS(
             const std::vector<std::vector<int>>& allSSubsets,
-            const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+            const std::vector<std::vector<size_t>>& sToJRanks,
+            const CombinadicRanker& ranker,
             const std::vector<std::vector<int>>& jGroups,
             int n,
             int k
@@ -103,6 +115,9 @@ private:
             
             return (numerator / denominator);  
         }
+
+    private:
+        size_t m_maxIncidenceBytes;  // 关联矩阵的内存预算
     };
 
     // Mode B的选择策略
@@ -110,7 +125,8 @@ private:
     public:
         std::vector<std::vector<int>> selectTopS(
             const std::vector<std::vector<int>>& allSSubsets,
-            const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+            const std::vector<std::vector<size_t>>& sToJRanks,
+            const CombinadicRanker& ranker,
             const std::vector<std::vector<int>>& jGroups,
             int n,
             int k
@@ -122,7 +138,8 @@ private:
     public:
         std::vector<std::vector<int>> selectTopS(
             const std::vector<std::vector<int>>& allSSubsets,
-            const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+            const std::vector<std::vector<size_t>>& sToJRanks,
+            const CombinadicRanker& ranker,
             const std::vector<std::vector<int>>& jGroups,
             int n,
             int k
@@ -134,6 +151,7 @@ private:
 private:
     std::shared_ptr<CombinationGenerator> m_combGen;
     std::shared_ptr<SetOperations> m_setOps;
+    Config m_config;
 };
 
 } // namespace core_algo 
\ No newline at end of file
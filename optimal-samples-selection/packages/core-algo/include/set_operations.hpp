@@ -1,6 +1,7 @@
 #pragma once
 
 #include "types.hpp"
+#include "combination_mask.hpp"
 #include <vector>
 #include <memory>
 #include <unordered_set>
@@ -55,6 +56,14 @@ public:
         const std::vector<int>& subset
     ) const = 0;
 
+    // 位掩码版本：子集检查退化为一次按位与比较，无需构建哈希集
+    bool contains(
+        CombinationMask container,
+        CombinationMask subset
+    ) const {
+        return isSubmask(container, subset);
+    }
+
     // 获取所有可能的组合
     virtual std::vector<int> getAllCombinations(
         const std::vector<std::vector<int>>& sets
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include "types.hpp"
+
+namespace core_algo {
+
+// 常驻线程池：工作线程在创建时启动并在整个生命周期内复用，避免每次计算都创建与回收线程
+// parallelFor 把区间切分为块后分配到各参与线程的本地队列，空闲线程从其他队列尾部窃取
+// 调用线程本身也参与执行，因此在工作线程内部嵌套调用不会死锁
+class ThreadPool {
+public:
+    // body(begin, end) 处理 [begin, end) 的一块
+    using RangeBody = std::function<void(size_t begin, size_t end)>;
+
+    virtual ~ThreadPool() = default;
+
+    // 参与并行计算的线程数（含调用线程），为1时所有工作在调用线程内串行执行
+    virtual size_t threadCount() const = 0;
+
+    // 并行处理 [begin, end)：grainSize 为每块的元素数，0 表示按线程数自动选择
+    // 任一块抛出的第一个异常在全部块结束后于调用线程重新抛出
+    virtual void parallelFor(size_t begin, size_t end, const RangeBody& body, size_t grainSize = 0) = 0;
+
+    // 自动选择的块大小：每个线程约分得 CHUNKS_PER_THREAD 块，且不小于 minGrain
+    static size_t chunkSize(size_t count, size_t threads, size_t minGrain = 1);
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    // 工厂方法：创建独立的线程池
+    static std::shared_ptr<ThreadPool> create(size_t threadCount);
+
+    // 获取进程内共享的线程池，线程数相同的调用方得到同一实例
+    static std::shared_ptr<ThreadPool> shared(size_t threadCount);
+
+    // 按配置获取共享线程池：未启用并行时为单线程，threadCount <= 0 时使用硬件并发数
+    static std::shared_ptr<ThreadPool> forConfig(const Config& config);
+};
+
+} // namespace core_algo
@@ -1,12 +1,72 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <cmath>
+#include <climits>
 
 namespace core_algo {
 
+// 扁平组合存储：所有组合按步长 stride 连续存放在同一缓冲区中
+// offsets 非空时为 CSR 分组形式：第 g 组包含组合下标 [offsets[g], offsets[g+1])
+struct FlatCombinations {
+    int stride = 0;                  // 每个组合的元素个数
+    std::vector<int> data;           // 组合元素，长度为 size() * stride
+    std::vector<size_t> offsets;     // 分组偏移（可选），长度为组数 + 1
+
+    size_t size() const { return stride > 0 ? data.size() / stride : 0; }
+    bool empty() const { return size() == 0; }
+
+    // 第 i 个组合的首元素指针，随后 stride 个元素属于该组合
+    const int* operator[](size_t i) const { return data.data() + i * stride; }
+    int* operator[](size_t i) { return data.data() + i * stride; }
+
+    // 复制出第 i 个组合
+    std::vector<int> at(size_t i) const {
+        const int* row = (*this)[i];
+        return std::vector<int>(row, row + stride);
+    }
+
+    size_t groupCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t groupBegin(size_t g) const { return offsets[g]; }
+    size_t groupEnd(size_t g) const { return offsets[g + 1]; }
+
+    // 追加一个组合
+    void push_back(const std::vector<int>& combination) {
+        if (stride == 0) {
+            stride = static_cast<int>(combination.size());
+        } else if (combination.size() != static_cast<size_t>(stride)) {
+            throw std::invalid_argument("组合大小与步长不一致");
+        }
+        data.insert(data.end(), combination.begin(), combination.end());
+    }
+
+    // 与嵌套向量形式互相转换
+    static FlatCombinations fromNested(const std::vector<std::vector<int>>& combinations) {
+        FlatCombinations flat;
+        if (!combinations.empty()) {
+            flat.stride = static_cast<int>(combinations.front().size());
+            flat.data.reserve(combinations.size() * flat.stride);
+        }
+        for (const auto& combination : combinations) {
+            flat.push_back(combination);
+        }
+        return flat;
+    }
+
+    std::vector<std::vector<int>> toNested() const {
+        std::vector<std::vector<int>> nested;
+        nested.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            nested.push_back(at(i));
+        }
+        return nested;
+    }
+};
+
 // 组合缓存结构体
 struct CombinationCache {
     std::vector<std::vector<std::vector<int>>> jGroupSSubsets;  // 每个j组合的s子集集合
@@ -20,21 +80,94 @@ enum class CoverageMode {
     CoverAllS        // Mode C: 覆盖所有s
 };
 
+// 按位压缩的动态位集：每个64位字存放64个状态，计数为逐字popcount
+class DynamicBitset {
+public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    DynamicBitset() = default;
+    explicit DynamicBitset(size_t size, bool value = false)
+        : m_size(size), m_words((size + WORD_BITS - 1) / WORD_BITS, value ? ~Word(0) : 0) {
+        clearTail();
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    bool operator[](size_t i) const { return (m_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1; }
+
+    void set(size_t i, bool value = true) {
+        const Word bit = Word(1) << (i % WORD_BITS);
+        m_words[i / WORD_BITS] = value ? (m_words[i / WORD_BITS] | bit) : (m_words[i / WORD_BITS] & ~bit);
+    }
+
+    // 置位的个数
+    size_t count() const {
+        size_t total = 0;
+        for (Word word : m_words) {
+            total += __builtin_popcountll(word);
+        }
+        return total;
+    }
+
+    // 第一个未置位的下标，全部置位时返回 size()
+    size_t findFirstUnset() const {
+        for (size_t w = 0; w < m_words.size(); ++w) {
+            if (~m_words[w]) {
+                const size_t i = w * WORD_BITS + __builtin_ctzll(~m_words[w]);
+                return i < m_size ? i : m_size;
+            }
+        }
+        return m_size;
+    }
+
+    // 底层字数组；同一字内的位不能由多个线程同时写入
+    Word* words() { return m_words.data(); }
+    const Word* words() const { return m_words.data(); }
+    size_t wordCount() const { return m_words.size(); }
+
+    bool operator==(const DynamicBitset& other) const {
+        return m_size == other.m_size && m_words == other.m_words;
+    }
+    bool operator!=(const DynamicBitset& other) const { return !(*this == other); }
+
+private:
+    size_t m_size = 0;
+    std::vector<Word> m_words;
+
+    // 末字中超出 size 的位保持为0，使 count 与比较不受其影响
+    void clearTail() {
+        if (m_size % WORD_BITS != 0) {
+            m_words.back() &= (Word(1) << (m_size % WORD_BITS)) - 1;
+        }
+    }
+};
+
+// 覆盖结果的详细程度
+enum class CoverageDetail {
+    RatioOnly,       // 只填写覆盖数与覆盖率，不分配逐j组合的数组
+    UncoveredList,   // 另外给出未覆盖j组合的下标列表
+    Full             // 每个j组合的覆盖状态与被覆盖s子集数
+};
+
 // 覆盖结果结构体
 struct CoverageResult {
     double coverage_ratio;                 // 覆盖率
     int covered_j_count;                  // 被覆盖的j组合数量
     int total_j_count;                    // 总j组合数量
-    std::vector<bool> j_coverage_status;  // 每个j组合的覆盖状态
-    std::vector<int> j_covered_s_counts;  // 每个j组合中被覆盖的s子集数量
+    DynamicBitset j_coverage_status;      // 每个j组合的覆盖状态（仅 Full）
+    std::vector<uint8_t> j_covered_s_counts;  // 每个j组合中被覆盖的s子集数量（仅 Full），不超过 C(7,3)=35，超过255时截断
+    std::vector<int> uncovered_j_indices; // 未覆盖j组合的升序下标（仅 UncoveredList）
     int total_groups;                     // 总组数
+    CoverageDetail detail = CoverageDetail::Full;
 
     CoverageResult() : coverage_ratio(0.0), covered_j_count(0), 
                       total_j_count(0), total_groups(0) {}
 
     CoverageResult(double ratio, int covered_count, int total_count,
-                  std::vector<bool> coverage_status,
-                  std::vector<int> covered_s_counts,
+                  DynamicBitset coverage_status,
+                  std::vector<uint8_t> covered_s_counts,
                   int groups = 0)
         : coverage_ratio(ratio),
           covered_j_count(covered_count),
@@ -44,6 +177,15 @@ struct CoverageResult {
           total_groups(groups) {}
 };
 
+// 候选k组相对于基准解的覆盖变化（批量评估结果）
+struct CoverageDelta {
+    int covered_j_delta = 0;              // 新满足覆盖要求的j组合数量
+    int covered_s_delta = 0;              // j_covered_s_counts 之和的增量
+
+    CoverageDelta() = default;
+    CoverageDelta(int j_delta, int s_delta) : covered_j_delta(j_delta), covered_s_delta(s_delta) {}
+};
+
 // 结果结构体
 struct Solution {
     std::vector<std::vector<int>> groups;  // 结果组集合
@@ -65,7 +207,8 @@ struct Config {
     double timeLimit = 0.0;           // 时间限制（秒），0表示无限制
     std::vector<int> inputSamples;   // 输入的样本集合，如果为空则生成随机样本
     bool enableCache = false;         // 是否启用缓存
-    size_t maxCacheSize = 1000;      // 最大缓存大小
+    size_t maxCacheSize = 1000;      // 最大缓存条目数
+    size_t maxCacheBytes = 256 << 20; // 缓存字节预算
     bool enableRandomization = false; // 是否启用随机化
     int randomSeed = 0;              // 随机种子，0表示使用随机设备
     bool useLetter = false;          // 是否使用字母表示样本
@@ -118,6 +261,8 @@ struct DetailedSolution : public Solution {
     std::string message;              // 详细信息
     double coverageRatio;            // 覆盖率
     bool isOptimal = false;          // 是否为最优解
+    int lowerBound = 0;              // 组数的下界（精确求解器给出，0表示未知）
+    double optimalityGap = 0.0;      // 与下界的相对差距 (totalGroups - lowerBound) / totalGroups
 
     bool operator==(const DetailedSolution& other) const {
         return status == other.status &&
@@ -2,6 +2,7 @@
 #include "set_operations.hpp"
 #include "combination_generator.hpp"
 #include "coverage_calculator.hpp"
+#include "combination_visitor.hpp"
 #include <chrono>
 #include <algorithm>
 #include <map>
@@ -25,18 +26,11 @@ CoverageResult BaseSolver::validateSolution(
     const std::vector<std::vector<int>>& groups,
     const std::vector<int>& samples,
     int j,
-    int s
+    int s,
+    CoverageDetail detail
 ) const {
-    auto jCombinations = m_combGen->generate(samples, j);
-    
-    // 为每个j组合生成s子集
-    std::vector<std::vector<std::vector<int>>> jGroupSSubsets;
-    jGroupSSubsets.resize(jCombinations.size());
-    for (size_t i = 0; i < jCombinations.size(); ++i) {
-        jGroupSSubsets[i] = m_combGen->generate(jCombinations[i], s);
-    }
-    
-    return m_covCalc->calculateCoverage(groups, jCombinations, jGroupSSubsets, CoverageMode::CoverMinOneS, 1);
+    // Mode A 的覆盖判定为 |k∩j| >= s，无需生成s子集
+    return m_covCalc->calculateModeACoverage(groups, samples, j, s, detail);
 }
 
 DetailedSolution BaseSolver::prepareSolution(
@@ -64,17 +58,17 @@ CombinationCache BaseSolver::generateCombinations(
 ) const {
     CombinationCache cache;
     
-    // 生成j组合
-    cache.jCombinations = m_combGen->generate(samples, j);
-    
     // 生成s子集
-    cache.sSubsets = m_combGen->generate(samples, s);
+    cache.allSSubsets = m_combGen->generate(samples, s);
     
-    // 为每个j组合生成对应的s子集
-    cache.jGroupSSubsets.resize(cache.jCombinations.size());
-    for (size_t i = 0; i < cache.jCombinations.size(); ++i) {
-        cache.jGroupSSubsets[i] = m_combGen->generate(cache.jCombinations[i], s);
-    }
+    // 逐个访问j组合（不物化j组合列表），为其生成对应的s子集
+    forEachCombination(samples, j, [&](CombinationView jGroup) {
+        cache.jGroupSSubsets.emplace_back();
+        auto& sSubsets = cache.jGroupSSubsets.back();
+        forEachCombination(jGroup, s, [&](CombinationView sSubset) {
+            sSubsets.push_back(sSubset.toVector());
+        });
+    });
     
     return cache;
 }
@@ -1,29 +1,33 @@
 #include "combination_generator.hpp"
+#include "combinadic.hpp"
+#include "generation_cache.hpp"
+#include "parameter_kernels.hpp"
+#include "thread_pool.hpp"
 #include <algorithm>
 #include <thread>
-#include <future>
+#include <mutex>
+#include <unordered_map>
 #include <cmath>
 #include <numeric>
-#include <unordered_map>
 #include <random>
 #include <iostream>
 
 namespace core_algo {
 
 namespace {
-    // 缓存键的哈希函数
-    struct CacheKeyHash {
-        size_t operator()(const std::pair<size_t, size_t>& key) const {
-            return std::hash<size_t>()(key.first) ^ (std::hash<size_t>()(key.second) << 1);
-        }
-    };
-
     class CombinationGeneratorImpl : public CombinationGenerator {
     private:
         Config m_config;
-        // 缓存常用的组合结果
-        mutable std::unordered_map<std::pair<size_t, size_t>, std::vector<std::vector<int>>, CacheKeyHash> m_combinationCache;
+        // 组合结果缓存（以元素内容为键，线程安全，可跨生成器共享）
+        std::shared_ptr<GenerationCache> m_cache;
         mutable std::mt19937 m_rng;  // 随机数生成器
+        mutable std::mutex m_rngMutex;
+        // 抽样用的随机数流：每个流一个生成器，使用时持有该流的互斥锁
+        struct RngStream {
+            std::mutex mutex;
+            std::mt19937 engine;
+        };
+        mutable std::unordered_map<size_t, std::unique_ptr<RngStream>> m_rngStreams;
         
         // 预分配的内存池
         class MemoryPool {
@@ -150,6 +154,26 @@ namespace {
                 return result;
             }
 
+            // 直接定位到字典序下标为 index 的组合，无需从头遍历
+            void seek(size_t index) {
+                if (m_r <= 0 || m_r > static_cast<int>(m_elements.size()) || index >= m_total) {
+                    m_hasNext = false;
+                    return;
+                }
+
+                if (m_elements.size() <= static_cast<size_t>(MAX_COMBINADIC_N)) {
+                    combinadicUnrank(index, static_cast<int>(m_elements.size()), m_r, m_indices.data());
+                    m_hasNext = true;
+                    m_count = index;
+                } else {
+                    // 超出二项式系数表范围时退化为逐个跳过
+                    reset();
+                    while (m_count < index && m_hasNext) {
+                        next();
+                    }
+                }
+            }
+
             void reset() override {
                 if (m_r <= 0 || m_r > static_cast<int>(m_elements.size())) {
                     m_hasNext = false;
@@ -200,6 +224,78 @@ namespace {
             return combinations;
         }
 
+        // 按字典序将 elements[0..n) 的全部r-元组合依次写入 out，返回写入的组合数
+        static size_t appendCombinationsFlat(const int* elements, int n, int r, int* out) {
+            if (r <= 0 || r > n) return 0;
+
+            // 参数网格内使用编译期特化的枚举内核
+            if (EnumerateKernel kernel = enumerateKernelFor(r)) {
+                kernel(elements, n, out);
+                return binomial(n, r);
+            }
+
+            int indices[MAX_COMBINADIC_N];
+            if (r > MAX_COMBINADIC_N) return 0;
+            for (int i = 0; i < r; ++i) {
+                indices[i] = i;
+            }
+
+            size_t written = 0;
+            while (true) {
+                for (int i = 0; i < r; ++i) {
+                    *out++ = elements[indices[i]];
+                }
+                ++written;
+
+                // 生成下一个索引组合
+                int i = r - 1;
+                while (i >= 0 && indices[i] == n - (r - i)) {
+                    --i;
+                }
+                if (i < 0) return written;
+                ++indices[i];
+                for (int t = i + 1; t < r; ++t) {
+                    indices[t] = indices[t - 1] + 1;
+                }
+            }
+        }
+
+        // 缓存查找：未启用缓存或启用随机化时总是返回空
+        GenerationCache::Value findCached(const std::vector<int>& elements, int r) const {
+            if (!m_cache || m_config.enableRandomization) return nullptr;
+            return m_cache->find(elements, r);
+        }
+
+        void storeCached(const std::vector<int>& elements, int r,
+                         const std::vector<std::vector<int>>& result) const {
+            if (!m_cache || m_config.enableRandomization) return;
+            m_cache->insert(elements, r, std::make_shared<const std::vector<std::vector<int>>>(result));
+        }
+
+        // 编号为 stream 的随机数流：种子由 Config::randomSeed 与流编号派生，
+        // 与调用线程无关；种子为0时使用随机设备。流在首次使用时创建，之后跨调用延续
+        RngStream& rngStream(size_t stream) const {
+            std::lock_guard<std::mutex> lock(m_rngMutex);
+            auto it = m_rngStreams.find(stream);
+            if (it != m_rngStreams.end()) {
+                return *it->second;
+            }
+
+            auto rng = std::make_unique<RngStream>();
+            if (m_config.randomSeed == 0) {
+                std::random_device rd;
+                rng->engine.seed(rd());
+            } else {
+                std::seed_seq seq{
+                    static_cast<unsigned>(m_config.randomSeed),
+                    static_cast<unsigned>(stream),
+                    static_cast<unsigned>(static_cast<uint64_t>(stream) >> 32)
+                };
+                rng->engine.seed(seq);
+            }
+            return *m_rngStreams.emplace(stream, std::move(rng)).first->second;
+        }
+
         // 辅助函数：将字母转换为数字（A->1, B->2, etc.）
         int letterToNum(char letter) {
             return static_cast<int>(letter - 'A' + 1);
@@ -219,6 +315,19 @@ namespace {
                 throw AlgorithmError("Invalid s value for generating subsets");
             }
 
+            // 参数网格内使用编译期特化的子集内核
+            const int j = static_cast<int>(j_combination.size());
+            if (SubsetKernel kernel = subsetKernelFor(j, s)) {
+                const size_t count = binomial(j, s);
+                int buffer[MAX_KERNEL_SIZE * 35];  // C(7, s) <= 35
+                kernel(j_combination.data(), buffer);
+                std::vector<std::vector<int>> s_subsets(count);
+                for (size_t c = 0; c < count; ++c) {
+                    s_subsets[c].assign(buffer + c * s, buffer + (c + 1) * s);
+                }
+                return s_subsets;
+            }
+
             // 直接从j组合中生成s子集
             std::vector<std::vector<int>> s_subsets;
             std::vector<int> current_subset(s);
@@ -281,6 +390,10 @@ namespace {
         explicit CombinationGeneratorImpl(const Config& config = Config())
             : m_config(config)
         {
+            if (m_config.enableCache) {
+                m_cache = GenerationCache::shared(m_config.maxCacheSize, m_config.maxCacheBytes);
+            }
+
             // 初始化随机数生成器
             if (m_config.enableRandomization) {
                 if (m_config.randomSeed == 0) {
@@ -298,24 +411,16 @@ namespace {
                 throw std::invalid_argument("n cannot be greater than m");
             }
             
-            // 生成1到m的序列
-            std::vector<int> numbers(m);
-            std::iota(numbers.begin(), numbers.end(), 1);
-            
-            // 使用随机设备生成种子
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            
-            // 随机选择n个数
+            // 从1到m中均匀抽取n个数（结果已升序）
+            RngStream& rng = rngStream(0);
             std::vector<int> samples;
-            samples.reserve(n);
-            
-            // 使用 std::shuffle 进行随机选择
-            std::shuffle(numbers.begin(), numbers.end(), gen);
-            samples.assign(numbers.begin(), numbers.begin() + n);
-            
-            // 排序以保持一致性
-            std::sort(samples.begin(), samples.end());
+            {
+                std::lock_guard<std::mutex> lock(rng.mutex);
+                samples = sampleUniform(m, n, rng.engine);
+            }
+            for (int& sample : samples) {
+                sample += 1;
+            }
             
             // 验证生成的样本数量
             if (samples.size() != static_cast<size_t>(n)) {
@@ -330,20 +435,14 @@ namespace {
             int r
         ) const override {
             // 检查缓存
-            auto cacheKey = std::make_pair(elements.size(), r);
-            if (m_config.enableCache && !m_config.enableRandomization) {
-                auto it = m_combinationCache.find(cacheKey);
-                if (it != m_combinationCache.end()) {
-                    return it->second;
-                }
+            if (auto cached = findCached(elements, r)) {
+                return *cached;
             }
 
             // 如果 r 等于输入序列的长度，直接返回输入序列作为唯一的组合
             if (r == static_cast<int>(elements.size())) {
                 std::vector<std::vector<int>> result = {elements};
-                if (m_config.enableCache && !m_config.enableRandomization) {
-                    m_combinationCache[cacheKey] = result;
-                }
+                storeCached(elements, r, result);
                 return result;
             }
 
@@ -360,14 +459,23 @@ namespace {
                 result.emplace_back(r);  // 每个内部vector预分配r个元素的空间
             }
             
-            // 初始化内存池
-            m_memoryPool.initialize(totalCombinations, r);
-            
-            // 使用迭代器生成组合
-            size_t index = 0;
-            auto it = std::make_unique<IteratorImpl>(elements, r, &m_memoryPool);
-            while (it->hasNext()) {
-                result[index++] = it->next();  // 直接赋值到预分配的空间
+            if (EnumerateKernel kernel = enumerateKernelFor(r)) {
+                // 参数网格内：特化内核写入连续缓冲区后逐行复制
+                std::vector<int> flat(totalCombinations * r);
+                kernel(elements.data(), static_cast<int>(elements.size()), flat.data());
+                for (size_t i = 0; i < totalCombinations; ++i) {
+                    std::copy(flat.begin() + i * r, flat.begin() + (i + 1) * r, result[i].begin());
+                }
+            } else {
+                // 初始化内存池
+                m_memoryPool.initialize(totalCombinations, r);
+                
+                // 使用迭代器生成组合
+                size_t index = 0;
+                auto it = std::make_unique<IteratorImpl>(elements, r, &m_memoryPool);
+                while (it->hasNext()) {
+                    result[index++] = it->next();  // 直接赋值到预分配的空间
+                }
             }
 
             // 如果启用随机化，打乱组合顺序
@@ -376,13 +484,196 @@ namespace {
             }
 
             // 更新缓存
-            if (m_config.enableCache && !m_config.enableRandomization) {
-                m_combinationCache[cacheKey] = result;
-            }
+            storeCached(elements, r, result);
             
             return result;
         }
 
+        std::vector<CombinationMask> generateMasks(
+            const std::vector<int>& samples,
+            int r
+        ) const override {
+            size_t totalCombinations = getCombinationCountFast(samples.size(), r);
+            if (r <= 0 || totalCombinations == 0) return {};
+
+            // 预先计算每个样本对应的位
+            std::vector<CombinationMask> bits;
+            bits.reserve(samples.size());
+            for (int sample : samples) {
+                bits.push_back(elementBit(sample));
+            }
+
+            std::vector<CombinationMask> result;
+            result.reserve(totalCombinations);
+
+            const int n = static_cast<int>(samples.size());
+            std::vector<int> indices(r);
+            for (int i = 0; i < r; ++i) {
+                indices[i] = i;
+            }
+
+            while (true) {
+                CombinationMask mask = 0;
+                for (int i = 0; i < r; ++i) {
+                    mask |= bits[indices[i]];
+                }
+                result.push_back(mask);
+
+                // 生成下一个索引组合
+                int i = r - 1;
+                while (i >= 0 && indices[i] == n - (r - i)) {
+                    --i;
+                }
+                if (i < 0) break;
+                ++indices[i];
+                for (int j = i + 1; j < r; ++j) {
+                    indices[j] = indices[i] + (j - i);
+                }
+            }
+
+            if (m_config.enableRandomization) {
+                std::shuffle(result.begin(), result.end(), m_rng);
+            }
+            return result;
+        }
+
+        FlatCombinations generateFlat(
+            const std::vector<int>& elements,
+            int r
+        ) const override {
+            FlatCombinations result;
+            size_t totalCombinations = getCombinationCountFast(elements.size(), r);
+            if (r <= 0 || totalCombinations == 0) return result;
+
+            // 一次性分配全部存储，逐行写入
+            result.stride = r;
+            result.data.resize(totalCombinations * r);
+            appendCombinationsFlat(elements.data(), static_cast<int>(elements.size()), r, result.data.data());
+
+            if (m_config.enableRandomization) {
+                // 按行打乱（Fisher-Yates）
+                for (size_t i = totalCombinations - 1; i > 0; --i) {
+                    size_t t = std::uniform_int_distribution<size_t>(0, i)(m_rng);
+                    std::swap_ranges(result[i], result[i] + r, result[t]);
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::vector<int>> generateRevolvingDoor(
+            const std::vector<int>& elements,
+            int r,
+            std::vector<CombinationSwap>* swaps
+        ) const override {
+            if (elements.size() > static_cast<size_t>(MAX_MASK_VALUE + 1)) {
+                throw AlgorithmError("旋转门顺序仅支持不超过64个元素");
+            }
+
+            std::vector<std::vector<int>> result;
+            result.reserve(getCombinationCountFast(elements.size(), r));
+            if (swaps) {
+                swaps->clear();
+                swaps->reserve(result.capacity());
+            }
+
+            forEachCombinationRevolvingDoor(elements, r,
+                [&](CombinationView combination, const CombinationSwap* swap) {
+                    result.push_back(combination.toVector());
+                    if (swap && swaps) {
+                        swaps->push_back(*swap);
+                    }
+                });
+            return result;
+        }
+
+        FlatCombinations generateFlatSSubsets(
+            const FlatCombinations& j_combinations,
+            int s
+        ) const override {
+            const int j = j_combinations.stride;
+            if (s <= 0 || s > j) {
+                throw AlgorithmError("Invalid s value for generating subsets");
+            }
+
+            // 每个j组合恰有 C(j, s) 个s子集，偏移可直接算出
+            const size_t perJ = getCombinationCountFast(j, s);
+            const size_t jCount = j_combinations.size();
+
+            FlatCombinations result;
+            result.stride = s;
+            result.data.resize(jCount * perJ * s);
+            result.offsets.resize(jCount + 1);
+            for (size_t g = 0; g <= jCount; ++g) {
+                result.offsets[g] = g * perJ;
+            }
+            SubsetKernel kernel = subsetKernelFor(j, s);
+            for (size_t g = 0; g < jCount; ++g) {
+                if (kernel) {
+                    kernel(j_combinations[g], result[result.offsets[g]]);
+                } else {
+                    appendCombinationsFlat(j_combinations[g], j, s, result[result.offsets[g]]);
+                }
+            }
+            return result;
+        }
+
+        std::vector<int> sampleUniform(
+            size_t n,
+            size_t r,
+            std::mt19937& rng
+        ) const override {
+            if (r > n) {
+                throw AlgorithmError("抽样大小不能超过元素数量");
+            }
+
+            // Floyd 算法：每步恰好选中一个新位置，共 r 次随机数
+            if (n <= static_cast<size_t>(MAX_MASK_VALUE + 1)) {
+                uint64_t chosen = 0;
+                for (size_t j = n - r; j < n; ++j) {
+                    size_t t = std::uniform_int_distribution<size_t>(0, j)(rng);
+                    chosen |= (chosen >> t) & 1 ? uint64_t(1) << j : uint64_t(1) << t;
+                }
+                // 位集按升序取出即为排序结果
+                std::vector<int> result;
+                result.reserve(r);
+                for (; chosen; chosen &= chosen - 1) {
+                    result.push_back(__builtin_ctzll(chosen));
+                }
+                return result;
+            }
+
+            std::vector<int> result;
+            result.reserve(r);
+            for (size_t j = n - r; j < n; ++j) {
+                int t = static_cast<int>(std::uniform_int_distribution<size_t>(0, j)(rng));
+                bool taken = std::find(result.begin(), result.end(), t) != result.end();
+                result.push_back(taken ? static_cast<int>(j) : t);
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        std::vector<std::vector<int>> sampleMany(
+            const std::vector<int>& elements,
+            int r,
+            size_t count,
+            size_t stream
+        ) const override {
+            if (r < 0) {
+                throw AlgorithmError("抽样大小不能为负数");
+            }
+            RngStream& rng = rngStream(stream);
+            std::lock_guard<std::mutex> lock(rng.mutex);
+            std::vector<std::vector<int>> result(count);
+            for (auto& combination : result) {
+                combination = sampleUniform(elements.size(), r, rng.engine);
+                for (int& value : combination) {
+                    value = elements[value];
+                }
+            }
+            return result;
+        }
+
         std::unique_ptr<Iterator> getIterator(
             const std::vector<int>& elements,
             int r
@@ -394,6 +685,44 @@ namespace {
             return getCombinationCountFast(n, r);
         }
 
+        size_t rank(const std::vector<int>& indices, size_t n) const override {
+            if (n > MAX_COMBINADIC_N || indices.size() > n) {
+                throw AlgorithmError("组合数系统参数超出范围");
+            }
+            for (size_t i = 0; i < indices.size(); ++i) {
+                if (indices[i] < 0 || indices[i] >= static_cast<int>(n) ||
+                    (i > 0 && indices[i] <= indices[i - 1])) {
+                    throw AlgorithmError("索引组合必须严格升序且位于 [0, n) 内");
+                }
+            }
+            return combinadicRank(indices.data(), static_cast<int>(indices.size()), static_cast<int>(n));
+        }
+
+        std::vector<int> unrank(size_t index, size_t n, size_t r) const override {
+            if (n > MAX_COMBINADIC_N || r > n || index >= binomial(static_cast<int>(n), static_cast<int>(r))) {
+                throw AlgorithmError("组合下标超出范围");
+            }
+            std::vector<int> indices(r);
+            combinadicUnrank(index, static_cast<int>(n), static_cast<int>(r), indices.data());
+            return indices;
+        }
+
+        size_t rankMask(CombinationMask mask, const std::vector<int>& samples) const override {
+            return CombinadicRanker(samples).rank(mask);
+        }
+
+        CombinationMask unrankMask(size_t index, const std::vector<int>& samples, size_t r) const override {
+            CombinadicRanker ranker(samples);
+            if (r > samples.size() || index >= ranker.count(static_cast<int>(r))) {
+                throw AlgorithmError("组合下标超出范围");
+            }
+            return ranker.unrank(index, static_cast<int>(r));
+        }
+
+        CacheStats getCacheStats() const override {
+            return m_cache ? m_cache->stats() : CacheStats();
+        }
+
         std::vector<std::vector<int>> generateParallel(
             const std::vector<int>& elements,
             int r,
@@ -404,74 +733,45 @@ namespace {
             }
 
             // 检查缓存（只在非随机化模式下使用缓存）
-            auto cacheKey = std::make_pair(elements.size(), r);
-            if (m_config.enableCache && !m_config.enableRandomization) {
-                auto it = m_combinationCache.find(cacheKey);
-                if (it != m_combinationCache.end()) {
-                    return it->second;
-                }
+            if (auto cached = findCached(elements, r)) {
+                return *cached;
             }
 
             size_t totalCombinations = getCombinationCountFast(elements.size(), r);
             if (totalCombinations == 0) return {};
 
-            // 优化线程数
-            threadCount = std::min({
+            auto pool = ThreadPool::shared(static_cast<size_t>(threadCount));
+
+            // 优化分段数：每段至少1000个组合
+            const size_t segments = std::max(1, std::min(
                 threadCount,
-                static_cast<int>(std::ceil(totalCombinations / 1000.0)),
-                static_cast<int>(std::thread::hardware_concurrency())
-            });
+                static_cast<int>(std::ceil(totalCombinations / 1000.0))
+            ));
             
-            std::vector<std::future<std::vector<std::vector<int>>>> futures;
-            std::vector<std::vector<int>> result;
-            result.reserve(totalCombinations);
+            // 预分配输出，每段写入互不重叠的区间
+            std::vector<std::vector<int>> result(totalCombinations);
 
-            // 计算每个线程的工作量
-            size_t combinationsPerThread = totalCombinations / threadCount;
-            size_t remainingCombinations = totalCombinations % threadCount;
+            // 计算每段的工作量
+            const size_t combinationsPerSegment = totalCombinations / segments;
+            const size_t remainingCombinations = totalCombinations % segments;
 
-            // 使用原子计数器跟踪进度
-            std::atomic<size_t> completedTasks(0);
+            // 各段提交到共享线程池，空闲线程可窃取其他线程尚未开始的段
+            pool->parallelFor(0, segments,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        const size_t startIdx = i * combinationsPerSegment + std::min(i, remainingCombinations);
+                        const size_t count = combinationsPerSegment + (i < remainingCombinations ? 1 : 0);
 
-            size_t startIdx = 0;
-            for (int i = 0; i < threadCount; ++i) {
-                size_t count = combinationsPerThread + (i < remainingCombinations ? 1 : 0);
-                
-                futures.push_back(std::async(std::launch::async,
-                    [this, &elements, r, startIdx, count, &completedTasks]() {
-                        std::vector<std::vector<int>> threadResult;
-                        threadResult.reserve(count);
-                        
-                        MemoryPool localPool;
-                        localPool.initialize(count, r);
+                        IteratorImpl it(elements, r);
                         
-                        auto it = std::make_unique<IteratorImpl>(elements, r, &localPool);
+                        // 通过反排序直接定位起始组合
+                        it.seek(startIdx);
                         
-                        // 跳过之前的组合
-                        for (size_t j = 0; j < startIdx && it->hasNext(); ++j) {
-                            it->next();
+                        for (size_t j = 0; j < count && it.hasNext(); ++j) {
+                            result[startIdx + j] = it.next();
                         }
-                        
-                        // 生成当前线程的组合
-                        for (size_t j = 0; j < count && it->hasNext(); ++j) {
-                            threadResult.push_back(it->next());
-                            ++completedTasks;
-                        }
-                        
-                        return threadResult;
                     }
-                ));
-                
-                startIdx += count;
-            }
-
-            // 收集结果
-            for (auto& future : futures) {
-                auto threadResult = future.get();
-                result.insert(result.end(), 
-                    std::make_move_iterator(threadResult.begin()),
-                    std::make_move_iterator(threadResult.end()));
-            }
+                }, 1);
 
             // 如果启用随机化，打乱最终结果
             if (m_config.enableRandomization) {
@@ -479,9 +779,7 @@ namespace {
             }
 
             // 更新缓存（只在非随机化模式下缓存）
-            if (m_config.enableCache && !m_config.enableRandomization) {
-                m_combinationCache[cacheKey] = result;
-            }
+            storeCached(elements, r, result);
 
             return result;
         }
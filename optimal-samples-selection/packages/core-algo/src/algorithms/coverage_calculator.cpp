@@ -1,24 +1,84 @@
 #include "coverage_calculator.hpp"
 #include "timer.hpp"
 #include "set_operations.hpp"
+#include "parameter_kernels.hpp"
+#include "combination_visitor.hpp"
+#include "combinadic.hpp"
+#include "thread_pool.hpp"
+#include "coverage_kernel.hpp"
+#include "covered_subset_table.hpp"
 #include <algorithm>
 #include <unordered_set>
-#include <thread>
 #include <vector>
 #include <mutex>
 #include <numeric>
 #include <iostream>
 #include <atomic>
 #include <chrono>
+#include <type_traits>
 
 namespace core_algo {
 
 namespace {
 
+// 被覆盖s子集数按 uint8_t 存储，超过255时截断
+uint8_t toCoveredCount(int covered_subsets) {
+    return static_cast<uint8_t>(std::min(covered_subsets, 255));
+}
+
+// 把 from 中被覆盖的s子集并入 into：参数网格内为单字位集，网格外为按 C(j, s) 分配的位集
+void mergeSubsetBits(uint64_t& into, uint64_t from) {
+    into |= from;
+}
+
+void mergeSubsetBits(DynamicBitset& into, const DynamicBitset& from) {
+    for (size_t w = 0; w < into.wordCount(); ++w) {
+        into.words()[w] |= from.words()[w];
+    }
+}
+
+// 按结果的详细程度逐块写入：块起点按 STREAM_BLOCK（64 的倍数）对齐，
+// 不同线程写入的状态位集字互不重叠，无需加锁
+class ResultWriter {
+public:
+    explicit ResultWriter(CoverageResult& result) : result(result) {}
+
+    void commit(size_t start, size_t count, const char* covered, const int* covered_s_counts) {
+        int local_covered_count = 0;
+        for (size_t c = 0; c < count; ++c) {
+            local_covered_count += covered[c] ? 1 : 0;
+        }
+        covered_count += local_covered_count;
+
+        if (result.detail == CoverageDetail::Full) {
+            for (size_t c = 0; c < count; ++c) {
+                if (covered[c]) result.j_coverage_status.set(start + c);
+                result.j_covered_s_counts[start + c] = toCoveredCount(covered_s_counts[c]);
+            }
+        } else if (result.detail == CoverageDetail::UncoveredList && local_covered_count < static_cast<int>(count)) {
+            std::lock_guard<std::mutex> lock(uncovered_mutex);
+            for (size_t c = 0; c < count; ++c) {
+                if (!covered[c]) result.uncovered_j_indices.push_back(static_cast<int>(start + c));
+            }
+        }
+    }
+
+    void finish() {
+        result.covered_j_count = covered_count;
+        std::sort(result.uncovered_j_indices.begin(), result.uncovered_j_indices.end());
+    }
+
+private:
+    CoverageResult& result;
+    std::atomic<int> covered_count{0};
+    std::mutex uncovered_mutex;
+};
+
 // 覆盖计算策略基类
 class CoverageStrategy {
 public:
-    CoverageStrategy() : set_ops(SetOperations::create()) {}
+    explicit CoverageStrategy(std::shared_ptr<ThreadPool> pool, CoverageDetail detail = CoverageDetail::Full)
+        : set_ops(SetOperations::create()), pool(std::move(pool)), detail(detail) {}
     virtual ~CoverageStrategy() = default;
 
     virtual CoverageResult calculate(
@@ -28,28 +88,98 @@ public:
         int min_coverage_count
     ) const = 0;
 
+    // 位掩码版本
+    virtual CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const = 0;
+
+    // 流式版本：j组合由 samples 按字典序在各块内直接枚举，不整体存储
+    virtual CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        int min_coverage_count
+    ) const = 0;
+
+    // 验证模式：s子集是否被覆盖由被覆盖s子集表查询，结果与位掩码版本一致
+    virtual CoverageResult verify(
+        const CoveredSubsetTable& table,
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        int min_coverage_count
+    ) const = 0;
+
+    // 第一个未满足覆盖要求的j组合下标，全部满足时返回 -1
+    virtual int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const = 0;
+
+    // 批量评估：每个候选为基准解加上一个候选k组
+    virtual std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const = 0;
+
 protected:
     std::unique_ptr<SetOperations> set_ops;
+    std::shared_ptr<ThreadPool> pool;
+    CoverageDetail detail;
+
+    // 每块至少包含的j组数，避免块过小时调度开销超过计算本身
+    static constexpr size_t MIN_GRAIN = 100;
+
+    // 位掩码与流式版本每次在栈上缓冲的j组合数
+    static constexpr size_t STREAM_BLOCK = 256;
+
+    // 辅助函数：按块处理时的并行粒度，取 STREAM_BLOCK 的整数倍使各块起点对齐
+    size_t alignedGrain(size_t data_size) const {
+        const size_t grain = ThreadPool::chunkSize(data_size, pool->threadCount(), STREAM_BLOCK);
+        return (grain + STREAM_BLOCK - 1) / STREAM_BLOCK * STREAM_BLOCK;
+    }
 
-    // 辅助函数：初始化结果结构
-    CoverageResult initializeResult(size_t j_size) const {
-        return CoverageResult(
+    // 辅助函数：初始化结果结构，只有 Full 级别分配逐j组合的数组
+    CoverageResult initializeResult(size_t j_size, CoverageDetail level = CoverageDetail::Full) const {
+        const bool full = level == CoverageDetail::Full;
+        CoverageResult result(
             0.0,                                    // coverage_ratio
             0,                                      // covered_j_count
             static_cast<int>(j_size),              // total_j_count
-            std::vector<bool>(j_size, false),      // j_coverage_status
-            std::vector<int>(j_size, 0),           // j_covered_s_counts
+            DynamicBitset(full ? j_size : 0),      // j_coverage_status
+            std::vector<uint8_t>(full ? j_size : 0, 0),  // j_covered_s_counts
             0                                      // total_groups
         );
+        result.detail = level;
+        return result;
     }
 
-    // 辅助函数：计算覆盖率
+    // 辅助函数：计算覆盖率；按完整结果计算的路径在此裁剪到所需的详细程度
     void finalizeResult(CoverageResult& result) const {
         if (result.total_j_count == 0) {
             result.coverage_ratio = 0.0;
         } else {
             result.coverage_ratio = static_cast<double>(result.covered_j_count) / result.total_j_count;
         }
+
+        if (result.detail == CoverageDetail::Full && detail != CoverageDetail::Full) {
+            if (detail == CoverageDetail::UncoveredList) {
+                for (size_t i = 0; i < result.j_coverage_status.size(); ++i) {
+                    if (!result.j_coverage_status[i]) result.uncovered_j_indices.push_back(static_cast<int>(i));
+                }
+            }
+            result.j_coverage_status = DynamicBitset();
+            result.j_covered_s_counts = std::vector<uint8_t>();
+            result.detail = detail;
+        }
     }
 
     // 辅助函数：检查一个s子集是否被任意k组完全覆盖
@@ -72,11 +202,310 @@ protected:
         
         return false;
     }
+
+    // 辅助函数：位掩码版本，子集检查为一次按位与比较
+    bool isSSubsetCoveredByAnyKGroup(
+        CombinationMask s_subset,
+        const std::vector<CombinationMask>& k_groups
+    ) const {
+        if (s_subset == 0) return false;
+
+        for (CombinationMask k_group : k_groups) {
+            if (isSubmask(k_group, s_subset)) return true;
+        }
+
+        return false;
+    }
+
+    // 辅助函数：流式计算的通用流程
+    // 每个并行块从起始下标还原第一个j组合，之后按字典序逐个推进，每攒满 STREAM_BLOCK 个调用一次
+    // evaluate_block(j_masks, count, covered, covered_s_counts)；除结果本身外只使用定长缓冲区
+    template <typename EvaluateBlock>
+    CoverageResult calculateStream(
+        size_t k_count,
+        const std::vector<int>& samples,
+        int j,
+        EvaluateBlock evaluate_block
+    ) const {
+        const int n = static_cast<int>(samples.size());
+        const size_t data_size = binomial(n, j);
+        auto result = initializeResult(data_size, detail);
+        result.total_groups = static_cast<int>(k_count);
+        if (data_size == 0 || j <= 0) {
+            finalizeResult(result);
+            return result;
+        }
+        if (n > MAX_COMBINADIC_N) {
+            throw AlgorithmError("样本数量超出组合数系统支持范围");
+        }
+
+        CombinationMask bits[MAX_COMBINADIC_N];
+        for (int i = 0; i < n; ++i) {
+            bits[i] = elementBit(samples[i]);
+        }
+
+        ResultWriter writer(result);
+        auto process_range = [&](size_t start, size_t end) {
+            int indices[MAX_COMBINADIC_N];
+            combinadicUnrank(start, n, j, indices);
+
+            CombinationMask j_masks[STREAM_BLOCK];
+            char covered[STREAM_BLOCK];
+            int covered_s_counts[STREAM_BLOCK];
+            for (size_t block = start; block < end; block += STREAM_BLOCK) {
+                const size_t count = std::min(STREAM_BLOCK, end - block);
+                for (size_t c = 0; c < count; ++c) {
+                    CombinationMask mask = 0;
+                    for (int i = 0; i < j; ++i) {
+                        mask |= bits[indices[i]];
+                    }
+                    j_masks[c] = mask;
+
+                    // 生成下一个索引组合
+                    int i = j - 1;
+                    while (i >= 0 && indices[i] == n - j + i) {
+                        --i;
+                    }
+                    if (i < 0) break;
+                    ++indices[i];
+                    for (int t = i + 1; t < j; ++t) {
+                        indices[t] = indices[t - 1] + 1;
+                    }
+                }
+
+                evaluate_block(j_masks, count, covered, covered_s_counts);
+                writer.commit(block, count, covered, covered_s_counts);
+            }
+        };
+
+        pool->parallelFor(0, data_size, process_range, alignedGrain(data_size));
+
+        writer.finish();
+        finalizeResult(result);
+        return result;
+    }
+
+    // 辅助函数：用逐个j组合的 evaluate 处理流式计算中的一块
+    template <typename Evaluate>
+    CoverageResult calculateStreamEach(
+        size_t k_count,
+        const std::vector<int>& samples,
+        int j,
+        Evaluate evaluate
+    ) const {
+        return calculateStream(k_count, samples, j,
+            [&](const CombinationMask* j_masks, size_t count, char* covered, int* covered_s_counts) {
+                for (size_t c = 0; c < count; ++c) {
+                    covered_s_counts[c] = 0;
+                    covered[c] = evaluate(j_masks[c], covered_s_counts[c]) ? 1 : 0;
+                }
+            });
+    }
+
+    // 辅助函数：提前退出的扫描流程，返回第一个未覆盖的j组合下标（全部覆盖时为 -1）
+    // evaluate_range(start, end, covered) 写出 covered[0 .. end-start)；每段至多 STREAM_BLOCK 个j组合
+    // 已发现的最小未覆盖下标保存在原子变量中，兼作取消标志：各线程在每段开始前检查，
+    // 段起点不小于该下标时其后不可能出现更小的下标，直接退出
+    template <typename EvaluateRange>
+    int scanFirstUncovered(
+        const std::vector<CombinationMask>& j_combinations,
+        EvaluateRange evaluate_range
+    ) const {
+        const size_t data_size = j_combinations.size();
+        std::atomic<size_t> first{data_size};
+
+        auto process_range = [&](size_t start, size_t end) {
+            char covered[STREAM_BLOCK];
+            for (size_t block = start; block < end; block += STREAM_BLOCK) {
+                if (block >= first.load(std::memory_order_relaxed)) return;
+                const size_t count = std::min(STREAM_BLOCK, end - block);
+                evaluate_range(block, block + count, covered);
+                for (size_t c = 0; c < count; ++c) {
+                    if (covered[c]) continue;
+                    size_t current = first.load();
+                    while (block + c < current && !first.compare_exchange_weak(current, block + c)) {
+                    }
+                    return;
+                }
+            }
+        };
+
+        pool->parallelFor(0, data_size, process_range,
+                          ThreadPool::chunkSize(data_size, pool->threadCount(), STREAM_BLOCK));
+
+        return first == data_size ? -1 : static_cast<int>(first.load());
+    }
+
+    // 辅助函数：用逐个j组合的 evaluate 执行提前退出的扫描
+    template <typename Evaluate>
+    int scanFirstUncoveredEach(
+        const std::vector<CombinationMask>& j_combinations,
+        Evaluate evaluate
+    ) const {
+        return scanFirstUncovered(j_combinations, [&](size_t start, size_t end, char* covered) {
+            for (size_t i = start; i < end; ++i) {
+                int covered_subsets = 0;
+                covered[i - start] = evaluate(j_combinations[i], covered_subsets) ? 1 : 0;
+            }
+        });
+    }
+
+    // 辅助函数：批量评估的通用流程
+    // subset_bits(j_mask, k_groups, k_count) 返回k组覆盖的j组s子集位集（单字或 DynamicBitset），
+    // score(j_mask, bits, covered_subsets) 由位集判断j组是否被覆盖，并写出被覆盖的s子集数
+    // 先一次性计算基准解在每个j组上的位集；候选按块并行，每块遍历一次j组，内层循环块内候选
+    template <typename SubsetBits, typename Score>
+    std::vector<CoverageDelta> evaluateCandidates(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        SubsetBits subset_bits,
+        Score score
+    ) const {
+        std::vector<CoverageDelta> deltas(candidate_groups.size());
+        const size_t data_size = j_combinations.size();
+        if (candidate_groups.empty() || data_size == 0 || s <= 0) {
+            return deltas;
+        }
+
+        using Bits = std::decay_t<decltype(subset_bits(CombinationMask(), base_solution.data(), size_t(0)))>;
+        std::vector<Bits> base_bits(data_size);
+        pool->parallelFor(0, data_size, [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                base_bits[i] = subset_bits(j_combinations[i], base_solution.data(), base_solution.size());
+            }
+        }, ThreadPool::chunkSize(data_size, pool->threadCount(), MIN_GRAIN));
+
+        // 每块写入各自的候选，互不重叠
+        pool->parallelFor(0, candidate_groups.size(), [&](size_t start, size_t end) {
+            for (size_t i = 0; i < data_size; ++i) {
+                const CombinationMask j_group = j_combinations[i];
+                int base_count = -1;
+                bool base_covered = false;
+                for (size_t c = start; c < end; ++c) {
+                    // 交集不足s的候选不覆盖该j组的任何s子集
+                    if (maskPopcount(candidate_groups[c] & j_group) < s) continue;
+                    Bits bits = subset_bits(j_group, &candidate_groups[c], 1);
+                    mergeSubsetBits(bits, base_bits[i]);
+                    if (bits == base_bits[i]) continue;
+                    if (base_count < 0) {
+                        base_count = 0;
+                        base_covered = score(j_group, base_bits[i], base_count);
+                    }
+                    int count = 0;
+                    const bool covered = score(j_group, bits, count);
+                    deltas[c].covered_j_delta += (covered && !base_covered) ? 1 : 0;
+                    deltas[c].covered_s_delta += count - base_count;
+                }
+            }
+        }, ThreadPool::chunkSize(candidate_groups.size(), pool->threadCount()));
+
+        return deltas;
+    }
+
+    // 辅助函数：参数网格外的s子集位集，第 i 位对应 forEachSubmaskOfSize 枚举的第 i 个s子集
+    DynamicBitset coveredSubsetBits(
+        CombinationMask j_group,
+        int s,
+        const CombinationMask* k_groups,
+        size_t k_count
+    ) const {
+        DynamicBitset bits(binomial(maskPopcount(j_group), s));
+        size_t index = 0;
+        forEachSubmaskOfSize(j_group, s, [&](CombinationMask s_subset) {
+            for (size_t g = 0; g < k_count; ++g) {
+                if (isSubmask(k_groups[g], s_subset)) {
+                    bits.set(index);
+                    break;
+                }
+            }
+            index++;
+            return true;
+        });
+        return bits;
+    }
+
+    // 辅助函数：按j组大小选取特化内核；j组大小不一致或超出参数网格时返回空
+    template <typename Kernel>
+    Kernel kernelForMasks(
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        Kernel (*select)(int, int)
+    ) const {
+        if (j_combinations.empty()) return nullptr;
+        const int j = maskPopcount(j_combinations.front());
+        for (CombinationMask j_group : j_combinations) {
+            if (maskPopcount(j_group) != j) return nullptr;
+        }
+        return select(j, s);
+    }
+
+    // 辅助函数：位掩码版本的通用计算流程
+    // evaluate(j_mask, covered_subsets) 返回该j组是否被覆盖，并写出被覆盖的s子集数
+    template <typename Evaluate>
+    CoverageResult calculateMasks(
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        Evaluate evaluate
+    ) const {
+        return calculateMaskRanges(k_count, j_combinations,
+            [&](size_t start, size_t end, char* covered, int* covered_s_counts) {
+                for (size_t i = start; i < end; ++i) {
+                    int covered_subsets = 0;
+                    covered[i - start] = evaluate(j_combinations[i], covered_subsets) ? 1 : 0;
+                    covered_s_counts[i - start] = covered_subsets;
+                }
+            });
+    }
+
+    // 辅助函数：按块计算的通用流程，供批量内核一次处理一段连续的j组
+    // evaluate_range(start, end, covered, covered_s_counts) 把 [start, end) 内每个j组的结果
+    // 写入块内缓冲区 covered[0 .. end-start) 与 covered_s_counts[0 .. end-start)；每段至多 STREAM_BLOCK 个j组
+    template <typename EvaluateRange>
+    CoverageResult calculateMaskRanges(
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        EvaluateRange evaluate_range
+    ) const {
+        auto result = initializeResult(j_combinations.size(), detail);
+        result.total_groups = static_cast<int>(k_count);
+
+        const size_t data_size = j_combinations.size();
+        if (data_size == 0) {
+            finalizeResult(result);
+            return result;
+        }
+
+        ResultWriter writer(result);
+        auto process_range = [&](size_t start, size_t end) {
+            char covered[STREAM_BLOCK];
+            int covered_s_counts[STREAM_BLOCK];
+            for (size_t block = start; block < end; block += STREAM_BLOCK) {
+                const size_t count = std::min(STREAM_BLOCK, end - block);
+                evaluate_range(block, block + count, covered, covered_s_counts);
+                writer.commit(block, count, covered, covered_s_counts);
+            }
+        };
+
+        pool->parallelFor(0, data_size, process_range, alignedGrain(data_size));
+
+        writer.finish();
+        finalizeResult(result);
+        return result;
+    }
 };
 
 // Mode A: 对每个j，检查是否至少有一个大小为s的子集被k组完全覆盖
 class CoverMinOneStrategy : public CoverageStrategy {
+private:
+    ModeACoverageKernel kernel;
+
 public:
+    CoverMinOneStrategy(std::shared_ptr<ThreadPool> pool, ModeACoverageKernel kernel,
+                        CoverageDetail detail = CoverageDetail::Full)
+        : CoverageStrategy(std::move(pool), detail), kernel(kernel) {}
+
     CoverageResult calculate(
         const std::vector<std::vector<int>>& k_groups,
         const std::vector<std::vector<int>>& j_combinations,
@@ -105,21 +534,14 @@ public:
         auto result = initializeResult(j_combinations.size());
         result.total_groups = static_cast<int>(k_groups.size());
         
-        // 优化线程数量：根据数据规模和CPU核心数动态调整
+        // 块大小：根据数据规模和线程池大小调整，每块至少 MIN_GRAIN 个j组
         const size_t data_size = j_combinations.size();
-        const unsigned int available_threads = std::thread::hardware_concurrency();
-        const unsigned int optimal_threads = std::min(
-            available_threads,
-            static_cast<unsigned int>((data_size + 99) / 100)  // 每100个项目分配一个线程
-        );
-        const size_t chunk_size = (data_size + optimal_threads - 1) / optimal_threads;
+        const size_t chunk_size = ThreadPool::chunkSize(data_size, pool->threadCount(), MIN_GRAIN);
         
         std::cout << "\n线程配置:" << std::endl;
-        std::cout << "- 可用CPU线程数: " << available_threads << std::endl;
-        std::cout << "- 优化后使用线程数: " << optimal_threads << std::endl;
-        std::cout << "- 每线程处理数据量: " << chunk_size << std::endl;
+        std::cout << "- 线程池线程数: " << pool->threadCount() << std::endl;
+        std::cout << "- 每块处理数据量: " << chunk_size << std::endl;
         
-        std::vector<std::thread> threads;
         std::atomic<int> covered_count{0};
         std::mutex result_mutex;
         std::mutex cout_mutex;  // 用于同步输出
@@ -154,25 +576,14 @@ public:
             {
                 std::lock_guard<std::mutex> lock(result_mutex);
                 for (size_t i = 0; i < end - start; ++i) {
-                    result.j_coverage_status[start + i] = local_coverage_status[i];
-                    result.j_covered_s_counts[start + i] = local_covered_s_counts[i];
+                    result.j_coverage_status.set(start + i, local_coverage_status[i]);
+                    result.j_covered_s_counts[start + i] = toCoveredCount(local_covered_s_counts[i]);
                 }
                 covered_count += local_covered_count;
             }
         };
 
-        // 创建并启动线程
-        threads.reserve(optimal_threads);
-        for (unsigned int i = 0; i < optimal_threads && i * chunk_size < j_combinations.size(); ++i) {
-            size_t start = i * chunk_size;
-            size_t end = std::min(start + chunk_size, j_combinations.size());
-            threads.emplace_back(process_range, start, end);
-        }
-
-        // 等待所有线程完成
-        for (auto& thread : threads) {
-            thread.join();
-        }
+        pool->parallelFor(0, j_combinations.size(), process_range, chunk_size);
 
         result.covered_j_count = covered_count;
         finalizeResult(result);
@@ -185,11 +596,136 @@ public:
         
         return result;
     }
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode A 覆盖计算（位掩码）");
+
+        // j组的某个s子集被k组覆盖，当且仅当 |k∩j| >= s：每个k组只需一次popcount，
+        // 由批量内核对一段j组同时计算
+        return calculateMaskRanges(k_groups.size(), j_combinations,
+            [&](size_t start, size_t end, char* covered, int* covered_s_counts) {
+                std::fill(covered, covered + (end - start), 0);
+                if (s > 0) {
+                    kernel(j_combinations.data() + start, end - start,
+                           k_groups.data(), k_groups.size(), s, covered);
+                }
+                for (size_t i = 0; i < end - start; ++i) {
+                    covered_s_counts[i] = covered[i];
+                }
+            });
+    }
+
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode A 覆盖计算（流式）");
+
+        return calculateStream(k_groups.size(), samples, j,
+            [&](const CombinationMask* j_masks, size_t count, char* covered, int* covered_s_counts) {
+                std::fill(covered, covered + count, 0);
+                if (s > 0) {
+                    kernel(j_masks, count, k_groups.data(), k_groups.size(), s, covered);
+                }
+                for (size_t c = 0; c < count; ++c) {
+                    covered_s_counts[c] = covered[c];
+                }
+            });
+    }
+
+    int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        return scanFirstUncovered(j_combinations, [&](size_t start, size_t end, char* covered) {
+            std::fill(covered, covered + (end - start), 0);
+            if (s > 0) {
+                kernel(j_combinations.data() + start, end - start, k_groups.data(), k_groups.size(), s, covered);
+            }
+        });
+    }
+
+    CoverageResult verify(
+        const CoveredSubsetTable& table,
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode A 覆盖验证（s子集表）");
+
+        return calculateMasks(k_count, j_combinations,
+            [&](CombinationMask j_group, int& covered_subsets) {
+                const bool j_group_covered = !table.forEachSubsetStatus(j_group, [](bool covered) {
+                    return !covered;
+                });
+                covered_subsets = j_group_covered ? 1 : 0;
+                return j_group_covered;
+            });
+    }
+
+    std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        // Mode A 只关心是否存在被覆盖的s子集，位集退化为1位
+        return evaluateCandidates(base_solution, candidate_groups, j_combinations, s,
+            [&](CombinationMask j_group, const CombinationMask* k_groups, size_t k_count) -> uint64_t {
+                return std::any_of(k_groups, k_groups + k_count,
+                    [&](CombinationMask k_group) { return maskPopcount(k_group & j_group) >= s; }) ? 1 : 0;
+            },
+            [](CombinationMask, uint64_t bits, int& covered_subsets) {
+                covered_subsets = bits ? 1 : 0;
+                return bits != 0;
+            });
+    }
 };
 
 // Mode B: 对每个j，检查是否有至少N个不同的大小为s的子集被k组完全覆盖
 class CoverMinNStrategy : public CoverageStrategy {
+private:
+    // 以逐个j组合的判定函数调用 consume：参数网格内按 k∩j 的局部掩码查表合并被覆盖的s子集，
+    // 覆盖数即位集的popcount；否则逐个检查s子集
+    template <typename Consume>
+    auto withEvaluator(
+        const std::vector<CombinationMask>& k_groups,
+        CoveredSubsetsKernel kernel,
+        int s,
+        int min_coverage_count,
+        Consume consume
+    ) const {
+        if (kernel) {
+            return consume([&, kernel](CombinationMask j_group, int& covered_subsets) {
+                covered_subsets = __builtin_popcountll(kernel(j_group, k_groups.data(), k_groups.size()));
+                return covered_subsets >= min_coverage_count;
+            });
+        }
+
+        return consume([&](CombinationMask j_group, int& covered_subsets) {
+            forEachSubmaskOfSize(j_group, s, [&](CombinationMask s_subset) {
+                if (isSSubsetCoveredByAnyKGroup(s_subset, k_groups)) {
+                    covered_subsets++;
+                }
+                return true;
+            });
+            return covered_subsets >= min_coverage_count;
+        });
+    }
+
 public:
+    using CoverageStrategy::CoverageStrategy;
+
     CoverageResult calculate(
         const std::vector<std::vector<int>>& k_groups,
         const std::vector<std::vector<int>>& j_combinations,
@@ -201,16 +737,8 @@ public:
         auto result = initializeResult(j_combinations.size());
         result.total_groups = static_cast<int>(k_groups.size());
 
-        // 优化线程数量
-        const size_t data_size = j_combinations.size();
-        const unsigned int available_threads = std::thread::hardware_concurrency();
-        const unsigned int optimal_threads = std::min(
-            available_threads,
-            static_cast<unsigned int>((data_size + 99) / 100)
-        );
-        const size_t chunk_size = (data_size + optimal_threads - 1) / optimal_threads;
+        const size_t chunk_size = ThreadPool::chunkSize(j_combinations.size(), pool->threadCount(), MIN_GRAIN);
 
-        std::vector<std::thread> threads;
         std::atomic<int> covered_count{0};
         std::mutex result_mutex;
 
@@ -242,35 +770,133 @@ public:
             {
                 std::lock_guard<std::mutex> lock(result_mutex);
                 for (size_t i = 0; i < end - start; ++i) {
-                    result.j_coverage_status[start + i] = local_coverage_status[i];
-                    result.j_covered_s_counts[start + i] = local_covered_s_counts[i];
+                    result.j_coverage_status.set(start + i, local_coverage_status[i]);
+                    result.j_covered_s_counts[start + i] = toCoveredCount(local_covered_s_counts[i]);
                 }
                 covered_count += local_covered_count;
             }
         };
 
-        // 创建并启动线程
-        threads.reserve(optimal_threads);
-        for (unsigned int i = 0; i < optimal_threads && i * chunk_size < j_combinations.size(); ++i) {
-            size_t start = i * chunk_size;
-            size_t end = std::min(start + chunk_size, j_combinations.size());
-            threads.emplace_back(process_range, start, end);
-        }
-
-        // 等待所有线程完成
-        for (auto& thread : threads) {
-            thread.join();
-        }
+        pool->parallelFor(0, j_combinations.size(), process_range, chunk_size);
 
         result.covered_j_count = covered_count;
         finalizeResult(result);
         return result;
     }
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode B 覆盖计算（位掩码）");
+
+        return withEvaluator(k_groups, kernelForMasks(j_combinations, s, coveredSubsetsKernelFor), s, min_coverage_count,
+            [&](auto evaluate) { return calculateMasks(k_groups.size(), j_combinations, evaluate); });
+    }
+
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode B 覆盖计算（流式）");
+
+        return withEvaluator(k_groups, coveredSubsetsKernelFor(j, s), s, min_coverage_count,
+            [&](auto evaluate) { return calculateStreamEach(k_groups.size(), samples, j, evaluate); });
+    }
+
+    int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        return withEvaluator(k_groups, kernelForMasks(j_combinations, s, coveredSubsetsKernelFor), s, min_coverage_count,
+            [&](auto evaluate) { return scanFirstUncoveredEach(j_combinations, evaluate); });
+    }
+
+    CoverageResult verify(
+        const CoveredSubsetTable& table,
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode B 覆盖验证（s子集表）");
+
+        return calculateMasks(k_count, j_combinations,
+            [&](CombinationMask j_group, int& covered_subsets) {
+                table.forEachSubsetStatus(j_group, [&](bool covered) {
+                    covered_subsets += covered ? 1 : 0;
+                    return true;
+                });
+                return covered_subsets >= min_coverage_count;
+            });
+    }
+
+    std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        auto kernel = kernelForMasks(j_combinations, s, coveredSubsetsKernelFor);
+        if (!kernel) {
+            return evaluateCandidates(base_solution, candidate_groups, j_combinations, s,
+                [&](CombinationMask j_group, const CombinationMask* k_groups, size_t k_count) {
+                    return coveredSubsetBits(j_group, s, k_groups, k_count);
+                },
+                [&](CombinationMask, const DynamicBitset& bits, int& covered_subsets) {
+                    covered_subsets = static_cast<int>(bits.count());
+                    return covered_subsets >= min_coverage_count;
+                });
+        }
+        return evaluateCandidates(base_solution, candidate_groups, j_combinations, s, kernel,
+            [&](CombinationMask, uint64_t bits, int& covered_subsets) {
+                covered_subsets = __builtin_popcountll(bits);
+                return covered_subsets >= min_coverage_count;
+            });
+    }
 };
 
 // Mode C: 对每个j，检查所有大小为s的子集是否都被k组完全覆盖
 class CoverAllStrategy : public CoverageStrategy {
+private:
+    // 以逐个j组合的判定函数调用 consume：参数网格内字典序前缀的覆盖数为位集最低连续1的个数；
+    // 否则按字典序检查s子集，遇到第一个未被覆盖的即停止
+    template <typename Consume>
+    auto withEvaluator(
+        const std::vector<CombinationMask>& k_groups,
+        CoveredSubsetsKernel kernel,
+        int j,
+        int s,
+        Consume consume
+    ) const {
+        if (kernel) {
+            const int subset_count = static_cast<int>(binomial(j, s));
+            return consume([&, kernel, subset_count](CombinationMask j_group, int& covered_subsets) {
+                const uint64_t uncovered = ~kernel(j_group, k_groups.data(), k_groups.size());
+                covered_subsets = uncovered ? std::min(__builtin_ctzll(uncovered), subset_count) : subset_count;
+                return covered_subsets == subset_count && covered_subsets > 0;
+            });
+        }
+
+        return consume([&](CombinationMask j_group, int& covered_subsets) {
+            bool all_subsets_covered = forEachSubmaskOfSize(j_group, s, [&](CombinationMask s_subset) {
+                if (!isSSubsetCoveredByAnyKGroup(s_subset, k_groups)) return false;
+                covered_subsets++;
+                return true;
+            });
+            return all_subsets_covered && covered_subsets > 0;
+        });
+    }
+
 public:
+    using CoverageStrategy::CoverageStrategy;
+
     CoverageResult calculate(
         const std::vector<std::vector<int>>& k_groups,
         const std::vector<std::vector<int>>& j_combinations,
@@ -282,15 +908,9 @@ public:
         auto result = initializeResult(j_combinations.size());
         result.total_groups = static_cast<int>(k_groups.size());
 
-        // 使用标准线程库进行并行处理
+        // 使用线程池进行并行处理
         std::mutex result_mutex;
-        const unsigned int available_threads = std::thread::hardware_concurrency();
-        const unsigned int optimal_threads = std::min(
-            available_threads,
-            static_cast<unsigned int>((j_combinations.size() + 99) / 100)
-        );
-        const size_t chunk_size = (j_combinations.size() + optimal_threads - 1) / optimal_threads;
-        std::vector<std::thread> threads;
+        const size_t chunk_size = ThreadPool::chunkSize(j_combinations.size(), pool->threadCount(), MIN_GRAIN);
         std::atomic<int> covered_count{0};
 
         auto process_range = [&](size_t start, size_t end) {
@@ -323,64 +943,252 @@ public:
             {
                 std::lock_guard<std::mutex> lock(result_mutex);
                 for (size_t i = 0; i < end - start; ++i) {
-                    result.j_coverage_status[start + i] = local_coverage_status[i];
-                    result.j_covered_s_counts[start + i] = local_covered_s_counts[i];
+                    result.j_coverage_status.set(start + i, local_coverage_status[i]);
+                    result.j_covered_s_counts[start + i] = toCoveredCount(local_covered_s_counts[i]);
                 }
                 covered_count += local_covered_count;
             }
         };
 
-        // 创建并启动线程
-        threads.reserve(optimal_threads);
-        for (unsigned int i = 0; i < optimal_threads && i * chunk_size < j_combinations.size(); ++i) {
-            size_t start = i * chunk_size;
-            size_t end = std::min(start + chunk_size, j_combinations.size());
-            threads.emplace_back(process_range, start, end);
-        }
-
-        // 等待所有线程完成
-        for (auto& thread : threads) {
-            thread.join();
-        }
+        pool->parallelFor(0, j_combinations.size(), process_range, chunk_size);
 
         result.covered_j_count = covered_count;
         finalizeResult(result);
         return result;
     }
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode C 覆盖计算（位掩码）");
+
+        const int j = j_combinations.empty() ? 0 : maskPopcount(j_combinations.front());
+        return withEvaluator(k_groups, kernelForMasks(j_combinations, s, coveredSubsetsKernelFor), j, s,
+            [&](auto evaluate) { return calculateMasks(k_groups.size(), j_combinations, evaluate); });
+    }
+
+    CoverageResult calculate(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode C 覆盖计算（流式）");
+
+        return withEvaluator(k_groups, coveredSubsetsKernelFor(j, s), j, s,
+            [&](auto evaluate) { return calculateStreamEach(k_groups.size(), samples, j, evaluate); });
+    }
+
+    int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        const int j = j_combinations.empty() ? 0 : maskPopcount(j_combinations.front());
+        return withEvaluator(k_groups, kernelForMasks(j_combinations, s, coveredSubsetsKernelFor), j, s,
+            [&](auto evaluate) { return scanFirstUncoveredEach(j_combinations, evaluate); });
+    }
+
+    CoverageResult verify(
+        const CoveredSubsetTable& table,
+        size_t k_count,
+        const std::vector<CombinationMask>& j_combinations,
+        int min_coverage_count
+    ) const override {
+        Timer timer("Mode C 覆盖验证（s子集表）");
+
+        return calculateMasks(k_count, j_combinations,
+            [&](CombinationMask j_group, int& covered_subsets) {
+                // 按字典序探测，遇到第一个未被覆盖的s子集即停止
+                const bool all_subsets_covered = table.forEachSubsetStatus(j_group, [&](bool covered) {
+                    if (!covered) return false;
+                    covered_subsets++;
+                    return true;
+                });
+                return all_subsets_covered && covered_subsets > 0;
+            });
+    }
+
+    std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        int min_coverage_count
+    ) const override {
+        auto kernel = kernelForMasks(j_combinations, s, coveredSubsetsKernelFor);
+        if (!kernel) {
+            // 与逐个检查的判定一致：覆盖数为字典序上第一个未覆盖s子集之前的个数
+            return evaluateCandidates(base_solution, candidate_groups, j_combinations, s,
+                [&](CombinationMask j_group, const CombinationMask* k_groups, size_t k_count) {
+                    return coveredSubsetBits(j_group, s, k_groups, k_count);
+                },
+                [&](CombinationMask, const DynamicBitset& bits, int& covered_subsets) {
+                    covered_subsets = static_cast<int>(bits.findFirstUnset());
+                    return covered_subsets == static_cast<int>(bits.size()) && covered_subsets > 0;
+                });
+        }
+        const int subset_count = static_cast<int>(binomial(maskPopcount(j_combinations.front()), s));
+        return evaluateCandidates(base_solution, candidate_groups, j_combinations, s, kernel,
+            [&](CombinationMask, uint64_t bits, int& covered_subsets) {
+                const uint64_t uncovered = ~bits;
+                covered_subsets = uncovered ? std::min(__builtin_ctzll(uncovered), subset_count) : subset_count;
+                return covered_subsets == subset_count && covered_subsets > 0;
+            });
+    }
 };
 
 } // namespace
 
 class CoverageCalculatorImpl : public CoverageCalculator {
 private:
-    std::unique_ptr<CoverageStrategy> createStrategy(CoverageMode mode) const {
+    std::shared_ptr<ThreadPool> m_pool;
+    ModeACoverageKernel m_modeAKernel;
+    size_t m_maxTableBytes;
+
+    std::unique_ptr<CoverageStrategy> createStrategy(
+        CoverageMode mode,
+        CoverageDetail detail = CoverageDetail::Full
+    ) const {
         switch (mode) {
             case CoverageMode::CoverMinOneS:
-                return std::make_unique<CoverMinOneStrategy>();
+                return std::make_unique<CoverMinOneStrategy>(m_pool, m_modeAKernel, detail);
             case CoverageMode::CoverMinNS:
-                return std::make_unique<CoverMinNStrategy>();
+                return std::make_unique<CoverMinNStrategy>(m_pool, detail);
             case CoverageMode::CoverAllS:
-                return std::make_unique<CoverAllStrategy>();
+                return std::make_unique<CoverAllStrategy>(m_pool, detail);
             default:
                 throw std::invalid_argument("未知的覆盖模式");
         }
     }
 
 public:
+    CoverageCalculatorImpl(std::shared_ptr<ThreadPool> pool, ModeACoverageKernel modeAKernel, size_t maxTableBytes)
+        : m_pool(std::move(pool)), m_modeAKernel(modeAKernel), m_maxTableBytes(maxTableBytes) {}
+
     CoverageResult calculateCoverage(
         const std::vector<std::vector<int>>& k_groups,
         const std::vector<std::vector<int>>& j_combinations,
         const std::vector<std::vector<std::vector<int>>>& s_subsets,
         CoverageMode mode,
+        int min_coverage_count,
+        CoverageDetail detail
+    ) const override {
+        auto strategy = createStrategy(mode, detail);
+        return strategy->calculate(k_groups, j_combinations, s_subsets, min_coverage_count);
+    }
+
+    CoverageResult calculateCoverage(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count,
+        CoverageDetail detail
+    ) const override {
+        auto strategy = createStrategy(mode, detail);
+        return strategy->calculate(k_groups, j_combinations, s, min_coverage_count);
+    }
+
+    CoverageResult verifyCoverage(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count,
+        CoverageDetail detail
+    ) const override {
+        // 只有落在某个j组合内的样本才会出现在被探测的s子集中
+        CombinationMask universe = 0;
+        for (CombinationMask j_group : j_combinations) {
+            universe |= j_group;
+        }
+        if (s <= 0 || CoveredSubsetTable::estimateBytes(maskPopcount(universe), s) > m_maxTableBytes) {
+            return calculateCoverage(k_groups, j_combinations, s, mode, min_coverage_count, detail);
+        }
+
+        const auto table = CoveredSubsetTable::build(k_groups, universe, s);
+        auto strategy = createStrategy(mode, detail);
+        return strategy->verify(table, k_groups.size(), j_combinations, min_coverage_count);
+    }
+
+    bool isFeasible(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count
+    ) const override {
+        return firstUncovered(k_groups, j_combinations, s, mode, min_coverage_count) < 0;
+    }
+
+    int firstUncovered(
+        const std::vector<CombinationMask>& k_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        CoverageMode mode,
         int min_coverage_count
     ) const override {
         auto strategy = createStrategy(mode);
-        return strategy->calculate(k_groups, j_combinations, s_subsets, min_coverage_count);
+        return strategy->firstUncovered(k_groups, j_combinations, s, min_coverage_count);
+    }
+
+    std::vector<CoverageDelta> evaluateBatch(
+        const std::vector<CombinationMask>& base_solution,
+        const std::vector<CombinationMask>& candidate_groups,
+        const std::vector<CombinationMask>& j_combinations,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count
+    ) const override {
+        auto strategy = createStrategy(mode);
+        return strategy->evaluateBatch(base_solution, candidate_groups, j_combinations, s, min_coverage_count);
+    }
+
+    CoverageResult calculateCoverage(
+        const std::vector<std::vector<int>>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count,
+        CoverageDetail detail
+    ) const override {
+        auto strategy = createStrategy(mode, detail);
+        return strategy->calculate(toMasks(k_groups), samples, j, s, min_coverage_count);
+    }
+
+    CoverageResult calculateModeACoverage(
+        const std::vector<std::vector<int>>& k_groups,
+        const std::vector<int>& samples,
+        int j,
+        int s,
+        CoverageDetail detail
+    ) const override {
+        return calculateCoverage(k_groups, samples, j, s, CoverageMode::CoverMinOneS, 1, detail);
+    }
+
+    CoverageResult calculateCoverage(
+        const FlatCombinations& k_groups,
+        const FlatCombinations& j_combinations,
+        int s,
+        CoverageMode mode,
+        int min_coverage_count,
+        CoverageDetail detail
+    ) const override {
+        // 扁平存储按行顺序扫描转换为掩码，再复用位掩码实现
+        return calculateCoverage(toMasks(k_groups), toMasks(j_combinations), s, mode, min_coverage_count, detail);
     }
 };
 
 std::unique_ptr<CoverageCalculator> CoverageCalculator::create(const Config& config) {
-    return std::make_unique<CoverageCalculatorImpl>();
+    // Mode A 批量内核按运行时检测到的指令集选择，检测只在首次创建时进行
+    static const ModeACoverageKernel modeAKernel = modeACoverageKernelFor(detectSimdLevel());
+    return std::make_unique<CoverageCalculatorImpl>(ThreadPool::forConfig(config), modeAKernel, config.maxCacheBytes);
 }
 
 } // namespace core_algo 
\ No newline at end of file
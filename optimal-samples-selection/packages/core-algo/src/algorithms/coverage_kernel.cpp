@@ -0,0 +1,175 @@
+#include "coverage_kernel.hpp"
+
+// 向量内核只在 GCC/Clang 的 x86 目标上编译：各函数通过 target 属性单独启用指令集，
+// 整个库无需 -mavx2 等全局编译选项，运行时按 CPUID 结果选择
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(__EMSCRIPTEN__)
+#define CORE_ALGO_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define CORE_ALGO_X86_SIMD 0
+#endif
+
+namespace core_algo {
+
+namespace {
+    bool coveredByAny(CombinationMask jGroup, const CombinationMask* kGroups, size_t kCount, int s) {
+        for (size_t x = 0; x < kCount; ++x) {
+            if (maskPopcount(kGroups[x] & jGroup) >= s) return true;
+        }
+        return false;
+    }
+
+    void modeAKernelScalar(
+        const CombinationMask* jGroups, size_t jCount,
+        const CombinationMask* kGroups, size_t kCount,
+        int s, char* covered
+    ) {
+        for (size_t i = 0; i < jCount; ++i) {
+            covered[i] = coveredByAny(jGroups[i], kGroups, kCount, s) ? 1 : 0;
+        }
+    }
+
+#if CORE_ALGO_X86_SIMD
+    // SSE4.2：每个向量 2 个 j 掩码；popcount 用 pshufb 半字节查表再由 psadbw 按64位求和，
+    // 64位有符号比较 pcmpgtq 为 SSE4.2 指令
+    __attribute__((target("sse4.2")))
+    void modeAKernelSse42(
+        const CombinationMask* jGroups, size_t jCount,
+        const CombinationMask* kGroups, size_t kCount,
+        int s, char* covered
+    ) {
+        const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m128i lowNibble = _mm_set1_epi8(0x0f);
+        const __m128i threshold = _mm_set1_epi64x(s - 1);
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 2 <= jCount; i += 2) {
+            const __m128i jVec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(jGroups + i));
+            __m128i any = zero;
+            for (size_t x = 0; x < kCount; ++x) {
+                const __m128i common = _mm_and_si128(jVec, _mm_set1_epi64x(static_cast<long long>(kGroups[x])));
+                const __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(common, lowNibble));
+                const __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(common, 4), lowNibble));
+                const __m128i count = _mm_sad_epu8(_mm_add_epi8(low, high), zero);
+                any = _mm_or_si128(any, _mm_cmpgt_epi64(count, threshold));
+                if (_mm_test_all_ones(any)) break;
+            }
+            const int bits = _mm_movemask_pd(_mm_castsi128_pd(any));
+            covered[i] = bits & 1;
+            covered[i + 1] = (bits >> 1) & 1;
+        }
+        modeAKernelScalar(jGroups + i, jCount - i, kGroups, kCount, s, covered + i);
+    }
+
+    // AVX2：每个向量 4 个 j 掩码，popcount 方法同 SSE4.2
+    __attribute__((target("avx2")))
+    void modeAKernelAvx2(
+        const CombinationMask* jGroups, size_t jCount,
+        const CombinationMask* kGroups, size_t kCount,
+        int s, char* covered
+    ) {
+        const __m256i lut = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+        const __m256i threshold = _mm256_set1_epi64x(s - 1);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i allOnes = _mm256_set1_epi64x(-1);
+
+        size_t i = 0;
+        for (; i + 4 <= jCount; i += 4) {
+            const __m256i jVec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(jGroups + i));
+            __m256i any = zero;
+            for (size_t x = 0; x < kCount; ++x) {
+                const __m256i common = _mm256_and_si256(jVec, _mm256_set1_epi64x(static_cast<long long>(kGroups[x])));
+                const __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(common, lowNibble));
+                const __m256i high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(common, 4), lowNibble));
+                const __m256i count = _mm256_sad_epu8(_mm256_add_epi8(low, high), zero);
+                any = _mm256_or_si256(any, _mm256_cmpgt_epi64(count, threshold));
+                if (_mm256_testc_si256(any, allOnes)) break;
+            }
+            const int bits = _mm256_movemask_pd(_mm256_castsi256_pd(any));
+            for (int lane = 0; lane < 4; ++lane) {
+                covered[i + lane] = (bits >> lane) & 1;
+            }
+        }
+        modeAKernelScalar(jGroups + i, jCount - i, kGroups, kCount, s, covered + i);
+    }
+
+    // AVX-512：每个向量 8 个 j 掩码，使用 VPOPCNTDQ 的原生64位popcount，比较结果直接得到掩码寄存器；
+    // 末尾不足 8 个时用掩码加载补零，零的popcount为0，不会被误判为覆盖
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    void modeAKernelAvx512(
+        const CombinationMask* jGroups, size_t jCount,
+        const CombinationMask* kGroups, size_t kCount,
+        int s, char* covered
+    ) {
+        const __m512i threshold = _mm512_set1_epi64(s - 1);
+        for (size_t i = 0; i < jCount; i += 8) {
+            const size_t lanes = jCount - i < 8 ? jCount - i : 8;
+            const __mmask8 active = static_cast<__mmask8>((1u << lanes) - 1);
+            const __m512i jVec = _mm512_maskz_loadu_epi64(active, jGroups + i);
+            __mmask8 any = 0;
+            for (size_t x = 0; x < kCount; ++x) {
+                const __m512i common = _mm512_and_si512(jVec, _mm512_set1_epi64(static_cast<long long>(kGroups[x])));
+                any |= _mm512_cmpgt_epi64_mask(_mm512_popcnt_epi64(common), threshold);
+                if (any == active) break;
+            }
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                covered[i + lane] = (any >> lane) & 1;
+            }
+        }
+    }
+#endif
+} // anonymous namespace
+
+SimdLevel detectSimdLevel() {
+#if CORE_ALGO_X86_SIMD
+    // __builtin_cpu_supports 同时检查 CPUID 与操作系统是否保存对应寄存器状态（XGETBV）
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SimdLevel::SSE42;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+ModeACoverageKernel modeACoverageKernelFor(SimdLevel level) {
+#if CORE_ALGO_X86_SIMD
+    switch (level) {
+        case SimdLevel::AVX512:
+            return modeAKernelAvx512;
+        case SimdLevel::AVX2:
+            return modeAKernelAvx2;
+        case SimdLevel::SSE42:
+            return modeAKernelSse42;
+        default:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    return modeAKernelScalar;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::SSE42:
+            return "SSE4.2";
+        default:
+            return "Scalar";
+    }
+}
+
+} // namespace core_algo
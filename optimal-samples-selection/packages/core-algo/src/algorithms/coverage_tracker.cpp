@@ -0,0 +1,254 @@
+#include "coverage_tracker.hpp"
+#include "combinadic.hpp"
+#include "combination_visitor.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace core_algo {
+
+namespace {
+    class CoverageTrackerImpl : public CoverageTracker {
+    private:
+        const std::vector<CombinationMask> m_jGroups;
+        const int m_s;
+        const int m_j;
+        const CoverageMode m_mode;
+        const int m_required;           // 满足覆盖要求所需的覆盖数
+        const size_t m_subsetsPerJ;     // Mode B/C：每个j组的s子集数 C(j, s)
+
+        std::vector<int> m_covered;                  // 每个j组的覆盖数（Mode A 为覆盖者数）
+        std::vector<uint32_t> m_subsetCoverers;      // Mode B/C：[j组下标 * C(j,s) + 局部下标] -> 包含该s子集的k组数
+        size_t m_uncovered;
+        std::unordered_map<CombinationMask, size_t> m_groups;  // 已添加的k组及其重数
+        size_t m_groupCount = 0;
+
+        // j组掩码 -> 下标：j组几乎是 m_universe 的全部j元组合时按组合数下标查表，否则用哈希表
+        // 相同掩码的j组按 m_nextSame 串成链
+        static constexpr size_t NONE = static_cast<size_t>(-1);
+        CombinationMask m_universe = 0;              // 全部j组的并集
+        std::unique_ptr<CombinadicRanker> m_ranker;
+        std::vector<size_t> m_firstByRank;
+        std::unordered_map<CombinationMask, size_t> m_firstByMask;
+        std::vector<size_t> m_nextSame;
+
+        bool isSatisfied(int covered) const {
+            return covered >= m_required;
+        }
+
+        // s子集在j组内的局部下标：按其在j组中的位置计算字典序下标
+        size_t localIndex(CombinationMask jGroup, CombinationMask subset) const {
+            int positions[MAX_MASK_VALUE + 1];
+            int count = 0;
+            while (subset) {
+                const CombinationMask bit = subset & (~subset + 1);
+                positions[count++] = maskPopcount(jGroup & (bit - 1));
+                subset &= subset - 1;
+            }
+            return combinadicRank(positions, count, m_j);
+        }
+
+        size_t firstIndexOf(CombinationMask jGroup) const {
+            if (m_ranker) {
+                return m_firstByRank[m_ranker->rank(jGroup)];
+            }
+            auto it = m_firstByMask.find(jGroup);
+            return it == m_firstByMask.end() ? NONE : it->second;
+        }
+
+        void buildIndex() {
+            for (CombinationMask jGroup : m_jGroups) {
+                m_universe |= jGroup;
+            }
+            const int universeSize = maskPopcount(m_universe);
+            if (universeSize <= MAX_COMBINADIC_N && binomial(universeSize, m_j) <= 2 * m_jGroups.size()) {
+                m_ranker = std::make_unique<CombinadicRanker>(fromMask(m_universe));
+                m_firstByRank.assign(m_ranker->count(m_j), NONE);
+            } else {
+                m_firstByMask.reserve(m_jGroups.size());
+            }
+
+            m_nextSame.assign(m_jGroups.size(), NONE);
+            for (size_t i = m_jGroups.size(); i-- > 0;) {
+                size_t& first = m_ranker ? m_firstByRank[m_ranker->rank(m_jGroups[i])]
+                                         : m_firstByMask.emplace(m_jGroups[i], NONE).first->second;
+                m_nextSame[i] = first;
+                first = i;
+            }
+        }
+
+        // 对每个与 kGroup 交集不小于s的j组调用 fn(j组下标, 交集)
+        // 受影响的j组为 T ∪ E：T 为 kGroup 的t元子集（s <= t <= j），E 为 kGroup 之外的 (j-t) 元组合，
+        // 交集恰为 T，每个j组只枚举一次；枚举量超过j组总数时（j组稀疏）改为逐个检查
+        template <typename Fn>
+        void forEachAffected(CombinationMask kGroup, Fn&& fn) const {
+            const CombinationMask inside = kGroup & m_universe;
+            const CombinationMask outside = m_universe & ~kGroup;
+            const int insideSize = maskPopcount(inside);
+            const int outsideSize = maskPopcount(outside);
+            const int maxCommon = std::min(insideSize, m_j);
+
+            size_t enumerated = 0;
+            for (int t = m_s; t <= maxCommon; ++t) {
+                enumerated += binomial(insideSize, t) * binomial(outsideSize, m_j - t);
+            }
+            if (enumerated > m_jGroups.size()) {
+                for (size_t i = 0; i < m_jGroups.size(); ++i) {
+                    const CombinationMask common = kGroup & m_jGroups[i];
+                    if (maskPopcount(common) >= m_s) {
+                        fn(i, common);
+                    }
+                }
+                return;
+            }
+
+            for (int t = m_s; t <= maxCommon; ++t) {
+                forEachSubmaskOfSize(inside, t, [&](CombinationMask common) {
+                    forEachSubmaskOfSize(outside, m_j - t, [&](CombinationMask rest) {
+                        for (size_t i = firstIndexOf(common | rest); i != NONE; i = m_nextSame[i]) {
+                            fn(i, common);
+                        }
+                        return true;
+                    });
+                    return true;
+                });
+            }
+        }
+
+        void update(CombinationMask kGroup, int delta) {
+            forEachAffected(kGroup, [&](size_t i, CombinationMask common) {
+                const bool before = isSatisfied(m_covered[i]);
+                if (m_mode == CoverageMode::CoverMinOneS) {
+                    m_covered[i] += delta;
+                } else {
+                    uint32_t* coverers = m_subsetCoverers.data() + i * m_subsetsPerJ;
+                    forEachSubmaskOfSize(common, m_s, [&](CombinationMask subset) {
+                        uint32_t& count = coverers[localIndex(m_jGroups[i], subset)];
+                        if (delta > 0 && count++ == 0) ++m_covered[i];
+                        if (delta < 0 && --count == 0) --m_covered[i];
+                        return true;
+                    });
+                }
+                const bool after = isSatisfied(m_covered[i]);
+                if (before != after) {
+                    after ? --m_uncovered : ++m_uncovered;
+                }
+            });
+        }
+
+    public:
+        CoverageTrackerImpl(std::vector<CombinationMask> jGroups, int s, CoverageMode mode, int minCoverageCount)
+            : m_jGroups(std::move(jGroups)),
+              m_s(s),
+              m_j(m_jGroups.empty() ? 0 : maskPopcount(m_jGroups.front())),
+              m_mode(mode),
+              m_required(mode == CoverageMode::CoverMinOneS ? 1
+                         : mode == CoverageMode::CoverMinNS ? minCoverageCount
+                         : static_cast<int>(binomial(m_j, s))),
+              m_subsetsPerJ(mode == CoverageMode::CoverMinOneS ? 0 : binomial(m_j, s)),
+              m_covered(m_jGroups.size(), 0),
+              m_uncovered(isSatisfied(0) ? 0 : m_jGroups.size())
+        {
+            if (s <= 0) {
+                throw AlgorithmError("s必须为正数");
+            }
+            for (CombinationMask jGroup : m_jGroups) {
+                if (maskPopcount(jGroup) != m_j) {
+                    throw AlgorithmError("j组大小不一致");
+                }
+            }
+            // s > j 时没有s子集，任何j组都无法满足
+            if (m_mode != CoverageMode::CoverMinOneS && m_subsetsPerJ == 0) {
+                throw AlgorithmError("s不能大于j");
+            }
+            m_subsetCoverers.assign(m_jGroups.size() * m_subsetsPerJ, 0);
+            buildIndex();
+        }
+
+        void addGroup(CombinationMask kGroup) override {
+            ++m_groups[kGroup];
+            ++m_groupCount;
+            update(kGroup, 1);
+        }
+
+        void removeGroup(CombinationMask kGroup) override {
+            auto it = m_groups.find(kGroup);
+            if (it == m_groups.end()) {
+                throw AlgorithmError("移除的k组未被添加");
+            }
+            if (--it->second == 0) {
+                m_groups.erase(it);
+            }
+            --m_groupCount;
+            update(kGroup, -1);
+        }
+
+        size_t uncoveredCount() const override {
+            return m_uncovered;
+        }
+
+        bool isFeasible() const override {
+            return m_uncovered == 0;
+        }
+
+        size_t marginalGain(CombinationMask kGroup) const override {
+            size_t gain = 0;
+            forEachAffected(kGroup, [&](size_t i, CombinationMask common) {
+                if (isSatisfied(m_covered[i])) return;
+                int covered = m_covered[i];
+                if (m_mode == CoverageMode::CoverMinOneS) {
+                    ++covered;
+                } else {
+                    const uint32_t* coverers = m_subsetCoverers.data() + i * m_subsetsPerJ;
+                    forEachSubmaskOfSize(common, m_s, [&](CombinationMask subset) {
+                        if (coverers[localIndex(m_jGroups[i], subset)] == 0) ++covered;
+                        return true;
+                    });
+                }
+                if (isSatisfied(covered)) ++gain;
+            });
+            return gain;
+        }
+
+        bool isCovered(size_t jIndex) const override {
+            return isSatisfied(m_covered.at(jIndex));
+        }
+
+        int coveredCount(size_t jIndex) const override {
+            return m_covered.at(jIndex);
+        }
+
+        size_t jGroupCount() const override {
+            return m_jGroups.size();
+        }
+
+        size_t groupCount() const override {
+            return m_groupCount;
+        }
+    };
+} // anonymous namespace
+
+std::unique_ptr<CoverageTracker> CoverageTracker::create(
+    const std::vector<int>& samples,
+    int j,
+    int s,
+    CoverageMode mode,
+    int minCoverageCount
+) {
+    std::vector<CombinationMask> jGroups;
+    jGroups.reserve(binomial(static_cast<int>(samples.size()), j));
+    forEachCombinationMask(samples, j, [&](CombinationMask jGroup) {
+        jGroups.push_back(jGroup);
+    });
+    return create(std::move(jGroups), s, mode, minCoverageCount);
+}
+
+std::unique_ptr<CoverageTracker> CoverageTracker::create(
+    std::vector<CombinationMask> jGroups,
+    int s,
+    CoverageMode mode,
+    int minCoverageCount
+) {
+    return std::make_unique<CoverageTrackerImpl>(std::move(jGroups), s, mode, minCoverageCount);
+}
+
+} // namespace core_algo
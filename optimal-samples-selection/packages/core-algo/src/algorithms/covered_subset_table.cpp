@@ -0,0 +1,50 @@
+#include "covered_subset_table.hpp"
+#include "combinadic.hpp"
+
+namespace core_algo {
+
+CoveredSubsetTable CoveredSubsetTable::build(
+    const std::vector<CombinationMask>& kGroups,
+    CombinationMask universe,
+    int s
+) {
+    CoveredSubsetTable table;
+    table.m_n = maskPopcount(universe);
+    table.m_s = s;
+    table.m_universe = universe;
+    table.m_direct = table.m_n <= DIRECT_MAX_BITS;
+    int position = 0;
+    for (CombinationMask rest = universe; rest; rest &= rest - 1) {
+        table.m_position[__builtin_ctzll(rest)] = position++;
+    }
+
+    const size_t bitCount = table.m_direct ? size_t(1) << table.m_n : binomial(table.m_n, s);
+    table.m_bits.assign((bitCount + WORD_BITS - 1) / WORD_BITS, 0);
+
+    for (CombinationMask kGroup : kGroups) {
+        forEachSubmaskOfSize(table.compress(kGroup), s, [&](CombinationMask local) {
+            const size_t bit = table.index(local);
+            table.m_bits[bit / WORD_BITS] |= Word(1) << (bit % WORD_BITS);
+            return true;
+        });
+    }
+    return table;
+}
+
+size_t CoveredSubsetTable::estimateBytes(int universeSize, int s) {
+    const size_t bitCount = universeSize <= DIRECT_MAX_BITS
+        ? size_t(1) << universeSize
+        : binomial(universeSize, s);
+    return (bitCount + WORD_BITS - 1) / WORD_BITS * sizeof(Word);
+}
+
+size_t CoveredSubsetTable::rank(CombinationMask local) const {
+    int indices[MAX_MASK_VALUE + 1];
+    int r = 0;
+    for (; local; local &= local - 1) {
+        indices[r++] = __builtin_ctzll(local);
+    }
+    return combinadicRank(indices, r, m_n);
+}
+
+} // namespace core_algo
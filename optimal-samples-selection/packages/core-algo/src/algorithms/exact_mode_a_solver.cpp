@@ -0,0 +1,380 @@
+#include "mode_a_solver.hpp"
+#include "combination_generator.hpp"
+#include "set_operations.hpp"
+#include "coverage_calculator.hpp"
+#include "incidence_matrix.hpp"
+#include "greedy_cover.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace core_algo {
+
+namespace {
+    using Word = IncidenceMatrix::Word;
+    constexpr size_t WORD_BITS = IncidenceMatrix::WORD_BITS;
+
+    // 分支定界搜索：k组 × j组关联矩阵上的最小集合覆盖
+    // - 分支：选择可用覆盖者最少的未覆盖j组，依次尝试覆盖它的每个k组（按新覆盖数从多到少）；
+    //   第 i 个分支排除前 i-1 个k组，各分支的解互不重复
+    // - 定界：两两之间没有共同覆盖者的未覆盖j组各需要一个不同的k组，其个数是还需k组数的下界；
+    //   未覆盖j组数除以单个k组的最大新覆盖数（向上取整）也是下界，取两者中较大的一个；
+    //   上界为当前最好解（初始为贪心解），已选数 + 下界不小于上界时剪枝
+    // - 对称性：k组与j组为样本的全部组合时，问题在样本置换下不变，任何解都可置换为包含第0个k组的解；
+    //   第二个k组只需对与第0个k组交集大小不同的每一类各尝试一个代表，已尝试的类在后续分支中排除
+    class BranchAndBound {
+    public:
+        BranchAndBound(const IncidenceMatrix& incidence,
+                       std::vector<size_t> incumbent,
+                       std::chrono::steady_clock::time_point deadline,
+                       bool hasDeadline)
+            : m_incidence(incidence),
+              m_best(std::move(incumbent)),
+              m_deadline(deadline),
+              m_hasDeadline(hasDeadline) {}
+
+        // 返回是否完整搜索（未超时）；groupMasks 非空时按样本置换对称处理前两层
+        bool run(const std::vector<CombinationMask>& groupMasks = {}) {
+            std::vector<Word> covered(m_incidence.wordsPerRow(), 0);
+            std::vector<Word> excluded(m_incidence.wordsPerColumn(), 0);
+            m_rootLowerBound = lowerBound(covered, excluded);
+            if (groupMasks.empty() || m_incidence.rowCount() == 0) {
+                search(covered, excluded, m_incidence.columnCount());
+            } else {
+                searchSymmetric(groupMasks, covered, excluded);
+            }
+            return !m_timedOut;
+        }
+
+        const std::vector<size_t>& best() const { return m_best; }
+        size_t rootLowerBound() const { return m_rootLowerBound; }
+
+    private:
+        static constexpr size_t TIME_CHECK_INTERVAL = 1024;
+
+        const IncidenceMatrix& m_incidence;
+        std::vector<size_t> m_best;
+        std::vector<size_t> m_chosen;
+        const std::chrono::steady_clock::time_point m_deadline;
+        const bool m_hasDeadline;
+        bool m_timedOut = false;
+        size_t m_nodes = 0;
+        size_t m_rootLowerBound = 0;
+
+        static bool test(const std::vector<Word>& bits, size_t i) {
+            return (bits[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+        }
+
+        // 未被排除的、覆盖第 c 个j组的k组数
+        size_t availableCoverers(size_t c, const std::vector<Word>& excluded) const {
+            const Word* coverers = m_incidence.column(c);
+            size_t count = 0;
+            for (size_t w = 0; w < excluded.size(); ++w) {
+                count += __builtin_popcountll(coverers[w] & ~excluded[w]);
+            }
+            return count;
+        }
+
+        // 两两之间没有共同可用覆盖者的未覆盖j组数，与按最大新覆盖数估计的组数中较大的一个
+        size_t lowerBound(const std::vector<Word>& covered, const std::vector<Word>& excluded) const {
+            size_t uncovered = 0;
+            for (size_t c = 0; c < m_incidence.columnCount(); ++c) {
+                if (!test(covered, c)) uncovered++;
+            }
+            size_t maxGain = 0;
+            for (size_t r = 0; r < m_incidence.rowCount(); ++r) {
+                if (!test(excluded, r)) maxGain = std::max(maxGain, m_incidence.countUncovered(r, covered.data()));
+            }
+            if (uncovered > 0 && maxGain == 0) return m_incidence.columnCount() + 1;  // 无法覆盖
+            size_t bound = maxGain > 0 ? (uncovered + maxGain - 1) / maxGain : 0;
+
+            std::vector<Word> blocked(excluded.size(), 0);  // 已计入的j组的可用覆盖者
+            size_t disjointCount = 0;
+            for (size_t c = 0; c < m_incidence.columnCount(); ++c) {
+                if (test(covered, c)) continue;
+                const Word* coverers = m_incidence.column(c);
+                bool disjoint = true;
+                for (size_t w = 0; w < blocked.size() && disjoint; ++w) {
+                    disjoint = (coverers[w] & ~excluded[w] & blocked[w]) == 0;
+                }
+                if (!disjoint) continue;
+                for (size_t w = 0; w < blocked.size(); ++w) {
+                    blocked[w] |= coverers[w] & ~excluded[w];
+                }
+                disjointCount++;
+            }
+            return std::max(bound, disjointCount);
+        }
+
+        bool outOfTime() {
+            ++m_nodes;
+            if (m_hasDeadline && m_nodes % TIME_CHECK_INTERVAL == 0 &&
+                std::chrono::steady_clock::now() >= m_deadline) {
+                m_timedOut = true;
+            }
+            return m_timedOut;
+        }
+
+        // 固定第0个k组，第二个k组按与它的交集大小分类，每类只尝试一个代表
+        void searchSymmetric(const std::vector<CombinationMask>& groupMasks,
+                             std::vector<Word> covered,
+                             std::vector<Word> excluded) {
+            m_incidence.mergeRow(0, covered.data());
+            excluded[0] |= 1;
+            size_t uncovered = m_incidence.columnCount() - m_incidence.rowDegree(0);
+            m_chosen.push_back(0);
+            if (uncovered == 0) {
+                if (m_chosen.size() < m_best.size()) m_best = m_chosen;
+                m_chosen.pop_back();
+                return;
+            }
+
+            std::vector<size_t> classOf(groupMasks.size());
+            std::vector<std::pair<size_t, size_t>> representatives;  // (新覆盖数, k组下标)
+            std::vector<bool> seen(MAX_MASK_VALUE + 1, false);
+            for (size_t r = 1; r < groupMasks.size(); ++r) {
+                classOf[r] = maskPopcount(groupMasks[r] & groupMasks[0]);
+                if (!seen[classOf[r]]) {
+                    seen[classOf[r]] = true;
+                    representatives.emplace_back(m_incidence.countUncovered(r, covered.data()), r);
+                }
+            }
+            std::sort(representatives.begin(), representatives.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            });
+
+            std::vector<Word> next(covered.size());
+            for (const auto& [gain, rep] : representatives) {
+                if (m_timedOut || m_chosen.size() + 1 >= m_best.size()) break;
+                std::copy(covered.begin(), covered.end(), next.begin());
+                m_incidence.mergeRow(rep, next.data());
+                m_chosen.push_back(rep);
+                search(next, excluded, uncovered - gain);
+                m_chosen.pop_back();
+                for (size_t r = 1; r < groupMasks.size(); ++r) {
+                    if (classOf[r] == classOf[rep]) excluded[r / WORD_BITS] |= Word(1) << (r % WORD_BITS);
+                }
+            }
+            m_chosen.pop_back();
+        }
+
+        void search(const std::vector<Word>& covered, std::vector<Word> excluded, size_t uncovered) {
+            if (uncovered == 0) {
+                if (m_chosen.size() < m_best.size()) m_best = m_chosen;
+                return;
+            }
+            if (outOfTime()) return;
+            // 至少还需要一个k组
+            if (m_chosen.size() + 1 >= m_best.size()) return;
+
+            // 可用覆盖者最少的未覆盖j组
+            size_t branchColumn = m_incidence.columnCount();
+            size_t fewest = 0;
+            for (size_t c = 0; c < m_incidence.columnCount(); ++c) {
+                if (test(covered, c)) continue;
+                const size_t count = availableCoverers(c, excluded);
+                if (count == 0) return;  // 该j组已无法被覆盖
+                if (branchColumn == m_incidence.columnCount() || count < fewest) {
+                    branchColumn = c;
+                    fewest = count;
+                }
+            }
+
+            if (m_chosen.size() + lowerBound(covered, excluded) >= m_best.size()) return;
+
+            // 覆盖该j组的k组，按新覆盖数从多到少尝试
+            std::vector<std::pair<size_t, size_t>> branches;  // (新覆盖数, k组下标)
+            branches.reserve(fewest);
+            const Word* coverers = m_incidence.column(branchColumn);
+            for (size_t w = 0; w < excluded.size(); ++w) {
+                Word bits = coverers[w] & ~excluded[w];
+                while (bits) {
+                    const size_t r = w * WORD_BITS + __builtin_ctzll(bits);
+                    branches.emplace_back(m_incidence.countUncovered(r, covered.data()), r);
+                    bits &= bits - 1;
+                }
+            }
+            std::sort(branches.begin(), branches.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            });
+
+            std::vector<Word> next(covered.size());
+            for (const auto& [gain, r] : branches) {
+                std::copy(covered.begin(), covered.end(), next.begin());
+                m_incidence.mergeRow(r, next.data());
+                m_chosen.push_back(r);
+                search(next, excluded, uncovered - gain);
+                m_chosen.pop_back();
+                if (m_timedOut || m_chosen.size() + 1 >= m_best.size()) return;
+                excluded[r / WORD_BITS] |= Word(1) << (r % WORD_BITS);
+            }
+        }
+    };
+
+    class ExactModeASolver : public ModeASolver {
+    private:
+        // 搜索截止时间为 start + Config::timeLimit；timeLimit 不大于0时不限时
+        bool hasDeadline() const { return m_config.timeLimit > 0.0; }
+
+        std::chrono::steady_clock::time_point deadlineFrom(std::chrono::steady_clock::time_point start) const {
+            return start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(m_config.timeLimit));
+        }
+
+        // 选中的k组覆盖的j组数
+        size_t coveredCount(const IncidenceMatrix& incidence, const std::vector<size_t>& selected) const {
+            size_t count = 0;
+            for (Word word : incidence.coveredColumns(selected)) {
+                count += __builtin_popcountll(word);
+            }
+            return count;
+        }
+
+        std::vector<std::vector<int>> toGroups(
+            const std::vector<size_t>& selected,
+            const std::vector<CombinationMask>& groupMasks
+        ) const {
+            std::vector<std::vector<int>> groups;
+            groups.reserve(selected.size());
+            for (size_t g : selected) {
+                groups.push_back(fromMask(groupMasks[g]));
+            }
+            return groups;
+        }
+
+    public:
+        ExactModeASolver(
+            std::shared_ptr<CombinationGenerator> combGen,
+            std::shared_ptr<SetOperations> setOps,
+            std::shared_ptr<CoverageCalculator> covCalc,
+            const Config& config
+        ) : ModeASolver(config) {
+            m_combGen = combGen;
+            m_setOps = setOps;
+            m_covCalc = covCalc;
+        }
+
+    protected:
+        CombinationResult generateCombinations(
+            int m,
+            int n,
+            const std::vector<int>& samples,
+            int k,
+            int s,
+            int j
+        ) override {
+            // 精确求解只需要k组与j组，不建立s子集映射
+            CombinationResult result;
+            result.groups = m_combGen->generate(samples, k);
+            result.jCombinations = m_combGen->generate(samples, j);
+
+            samples_ = samples;
+            jGroups_ = result.jCombinations;
+            candidates_ = result.groups;
+            return result;
+        }
+
+    public:
+        std::vector<std::vector<int>> performSelection(
+            const std::vector<std::vector<int>>& groups,
+            const std::vector<std::vector<int>>& jCombinations,
+            const std::vector<std::vector<int>>& sSubsets,
+            int j,
+            int s
+        ) const override {
+            const auto groupMasks = toMasks(groups);
+            const auto jMasks = toMasks(jCombinations);
+            if (IncidenceMatrix::estimateBytes(groupMasks.size(), jMasks.size()) > m_config.maxCacheBytes) {
+                throw AlgorithmError("关联矩阵超出内存预算，无法进行精确求解");
+            }
+            const auto incidence = IncidenceMatrix::forCoverage(
+                groupMasks, jMasks, j, s, CoverageMode::CoverMinOneS, 1,
+                m_config.enableParallel ? m_config.threadCount : 1);
+
+            // 贪心解作为初始上界；贪心无法覆盖时任何解都无法覆盖
+            auto incumbent = lazyGreedyCover(incidence, groupMasks, jMasks, s);
+            if (coveredCount(incidence, incumbent) < jMasks.size()) return {};
+
+            // 超时返回当前最好解；传入的k组不一定是全部组合，不做对称处理
+            BranchAndBound search(incidence, std::move(incumbent),
+                                  deadlineFrom(std::chrono::steady_clock::now()), hasDeadline());
+            search.run();
+            return toGroups(search.best(), groupMasks);
+        }
+
+        DetailedSolution solve(
+            int m,
+            int n,
+            const std::vector<int>& samples,
+            int k,
+            int s,
+            int j
+        ) override {
+            auto startTime = std::chrono::steady_clock::now();
+
+            DetailedSolution solution;
+            solution.isOptimal = false;
+
+            auto finish = [&](Status status, std::string message) {
+                auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(
+                    std::chrono::steady_clock::now() - startTime);
+                solution.status = status;
+                solution.message = std::move(message);
+                solution.totalGroups = static_cast<int>(solution.groups.size());
+                solution.computationTime = duration.count();
+                return solution;
+            };
+
+            const auto groupMasks = m_combGen->generateMasks(samples, k);
+            const auto jMasks = m_combGen->generateMasks(samples, j);
+            if (IncidenceMatrix::estimateBytes(groupMasks.size(), jMasks.size()) > m_config.maxCacheBytes) {
+                solution.coverageRatio = 0.0;
+                return finish(Status::Error, "Incidence matrix exceeds the memory budget for exact search");
+            }
+
+            // 关联矩阵只构建一次，贪心与分支定界共用
+            const auto incidence = IncidenceMatrix::forCoverage(
+                groupMasks, jMasks, j, s, CoverageMode::CoverMinOneS, 1,
+                m_config.enableParallel ? m_config.threadCount : 1);
+
+            // 贪心解作为初始上界；贪心无法覆盖时任何解都无法覆盖
+            auto greedy = lazyGreedyCover(incidence, groupMasks, jMasks, s);
+            const size_t greedyCovered = coveredCount(incidence, greedy);
+            if (greedyCovered < jMasks.size()) {
+                solution.groups = toGroups(greedy, groupMasks);
+                solution.coverageRatio = jMasks.empty() ? 0.0 : static_cast<double>(greedyCovered) / jMasks.size();
+                return finish(Status::NoSolution, "Candidate groups cannot cover all j groups");
+            }
+
+            BranchAndBound search(incidence, std::move(greedy), deadlineFrom(startTime), hasDeadline());
+            // 候选k组与j组都是样本的全部组合，可按样本置换对称处理
+            const bool complete = search.run(groupMasks);
+
+            solution.groups = toGroups(search.best(), groupMasks);
+            solution.coverageRatio = 1.0;
+            const size_t upper = search.best().size();
+            const size_t lower = complete ? upper : std::min(search.rootLowerBound(), upper);
+            solution.lowerBound = static_cast<int>(lower);
+            solution.optimalityGap = upper > 0 ? static_cast<double>(upper - lower) / upper : 0.0;
+
+            if (!complete) {
+                return finish(Status::Timeout,
+                              "Time limit reached; best solution has " + std::to_string(upper) +
+                              " groups, lower bound " + std::to_string(lower));
+            }
+            solution.isOptimal = true;
+            return finish(Status::Success, "Exact Mode A solver proved optimality");
+        }
+    };
+} // anonymous namespace
+
+std::shared_ptr<ModeASolver> createExactModeASolver(
+    std::shared_ptr<CombinationGenerator> combGen,
+    std::shared_ptr<SetOperations> setOps,
+    std::shared_ptr<CoverageCalculator> covCalc,
+    const Config& config
+) {
+    return std::make_shared<ExactModeASolver>(combGen, setOps, covCalc, config);
+}
+
+} // namespace core_algo
@@ -0,0 +1,136 @@
+#include "generation_cache.hpp"
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace core_algo {
+
+namespace {
+    // 缓存键：元素内容 + r
+    struct CacheKey {
+        std::vector<int> elements;
+        int r;
+
+        bool operator==(const CacheKey& other) const {
+            return r == other.r && elements == other.elements;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            size_t hash = std::hash<int>()(key.r);
+            for (int elem : key.elements) {
+                hash ^= std::hash<int>()(elem) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    // 估算一个缓存条目占用的字节数
+    size_t estimateBytes(const CacheKey& key, const GenerationCache::Combinations& value) {
+        size_t bytes = sizeof(CacheKey) + key.elements.size() * sizeof(int);
+        bytes += sizeof(GenerationCache::Combinations);
+        for (const auto& combination : value) {
+            bytes += sizeof(std::vector<int>) + combination.capacity() * sizeof(int);
+        }
+        return bytes;
+    }
+
+    class GenerationCacheImpl : public GenerationCache {
+    private:
+        struct Entry {
+            CacheKey key;
+            Value value;
+            size_t bytes;
+        };
+
+        const size_t m_maxEntries;
+        const size_t m_maxBytes;
+
+        mutable std::mutex m_mutex;
+        std::list<Entry> m_lru;  // 表头为最近使用
+        std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash> m_index;
+        CacheStats m_stats;
+
+        // 淘汰最久未使用的条目直到满足限制，调用方须持有锁
+        void evictUntilWithinLimits() {
+            while (!m_lru.empty() &&
+                   (m_lru.size() > m_maxEntries || m_stats.bytes > m_maxBytes)) {
+                auto& victim = m_lru.back();
+                m_stats.bytes -= victim.bytes;
+                m_index.erase(victim.key);
+                m_lru.pop_back();
+                ++m_stats.evictions;
+            }
+            m_stats.entries = m_lru.size();
+        }
+
+    public:
+        GenerationCacheImpl(size_t maxEntries, size_t maxBytes)
+            : m_maxEntries(maxEntries), m_maxBytes(maxBytes) {}
+
+        Value find(const std::vector<int>& elements, int r) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_index.find(CacheKey{elements, r});
+            if (it == m_index.end()) {
+                ++m_stats.misses;
+                return nullptr;
+            }
+            ++m_stats.hits;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return it->second->value;
+        }
+
+        void insert(const std::vector<int>& elements, int r, Value value) override {
+            if (!value) return;
+            CacheKey key{elements, r};
+            size_t bytes = estimateBytes(key, *value);
+            if (bytes > m_maxBytes || m_maxEntries == 0) return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_index.find(key);
+            if (it != m_index.end()) {
+                // 并发生成同一结果时保留已有条目
+                m_lru.splice(m_lru.begin(), m_lru, it->second);
+                return;
+            }
+            m_lru.push_front(Entry{key, std::move(value), bytes});
+            m_index.emplace(std::move(key), m_lru.begin());
+            m_stats.bytes += bytes;
+            evictUntilWithinLimits();
+        }
+
+        CacheStats stats() const override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+        void clear() override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lru.clear();
+            m_index.clear();
+            m_stats.entries = 0;
+            m_stats.bytes = 0;
+        }
+    };
+} // anonymous namespace
+
+std::shared_ptr<GenerationCache> GenerationCache::create(size_t maxEntries, size_t maxBytes) {
+    return std::make_shared<GenerationCacheImpl>(maxEntries, maxBytes);
+}
+
+std::shared_ptr<GenerationCache> GenerationCache::shared(size_t maxEntries, size_t maxBytes) {
+    static std::mutex registryMutex;
+    // 共享缓存在进程生命周期内保留，使后续请求可以复用已生成的结果
+    static std::map<std::pair<size_t, size_t>, std::shared_ptr<GenerationCache>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto& cache = registry[{maxEntries, maxBytes}];
+    if (!cache) {
+        cache = create(maxEntries, maxBytes);
+    }
+    return cache;
+}
+
+} // namespace core_algo
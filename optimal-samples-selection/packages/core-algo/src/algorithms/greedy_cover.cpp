@@ -0,0 +1,150 @@
+#include "greedy_cover.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace core_algo {
+
+namespace {
+    // 集合覆盖的边际增益只会随已选k组增加而减小，堆中的旧增益因此是上界：
+    // 堆顶的增益若在本轮已重新计算过，它一定是当前增益最大的k组，直接选中；否则重新计算后放回
+    struct HeapEntry {
+        size_t gain;
+        size_t group;
+        size_t round;   // 计算该增益时已选的k组数
+
+        // 增益相同时下标小的优先，使结果与堆的实现无关
+        bool operator<(const HeapEntry& other) const {
+            if (gain != other.gain) return gain < other.gain;
+            return group > other.group;
+        }
+    };
+
+    // 已选k组覆盖的j组，及按需计算的增益
+    // 关联矩阵超出内存预算时逐个检查未覆盖的j组
+    class Coverage {
+    public:
+        Coverage(const IncidenceMatrix& incidence,
+                 const std::vector<CombinationMask>& groupMasks,
+                 const std::vector<CombinationMask>& jMasks,
+                 int s)
+            : m_incidence(incidence), m_groupMasks(groupMasks), m_jMasks(jMasks), m_s(s),
+              m_covered(jMasks.size()), m_uncoveredCount(jMasks.size()) {
+            if (m_incidence.empty()) {
+                m_uncovered.resize(jMasks.size());
+                for (size_t jIdx = 0; jIdx < jMasks.size(); ++jIdx) {
+                    m_uncovered[jIdx] = jIdx;
+                }
+            }
+        }
+
+        size_t uncoveredCount() const { return m_uncoveredCount; }
+
+        size_t gain(size_t g) const {
+            if (!m_incidence.empty()) {
+                return m_incidence.countUncovered(g, m_covered.words());
+            }
+            size_t count = 0;
+            for (size_t jIdx : m_uncovered) {
+                if (maskPopcount(m_groupMasks[g] & m_jMasks[jIdx]) >= m_s) count++;
+            }
+            return count;
+        }
+
+        void add(size_t g) {
+            if (!m_incidence.empty()) {
+                m_incidence.mergeRow(g, m_covered.words());
+                m_uncoveredCount = m_jMasks.size() - m_covered.count();
+                return;
+            }
+            auto last = std::remove_if(m_uncovered.begin(), m_uncovered.end(), [&](size_t jIdx) {
+                if (maskPopcount(m_groupMasks[g] & m_jMasks[jIdx]) < m_s) return false;
+                m_covered.set(jIdx);
+                return true;
+            });
+            m_uncovered.erase(last, m_uncovered.end());
+            m_uncoveredCount = m_uncovered.size();
+        }
+
+    private:
+        const IncidenceMatrix& m_incidence;
+        const std::vector<CombinationMask>& m_groupMasks;
+        const std::vector<CombinationMask>& m_jMasks;
+        const int m_s;
+        DynamicBitset m_covered;
+        std::vector<size_t> m_uncovered;   // 无关联矩阵时的未覆盖j组下标
+        size_t m_uncoveredCount;
+    };
+
+    // 去掉冗余的k组：按选中的逆序检查，其覆盖的每个j组都还被其他已选k组覆盖时移除
+    std::vector<size_t> removeRedundant(
+        std::vector<size_t> selected,
+        const IncidenceMatrix& incidence,
+        const std::vector<CombinationMask>& groupMasks,
+        const std::vector<CombinationMask>& jMasks,
+        int s
+    ) {
+        auto coversJ = [&](size_t g, size_t jIdx) {
+            if (!incidence.empty()) return incidence.covers(g, jIdx);
+            return maskPopcount(groupMasks[g] & jMasks[jIdx]) >= s;
+        };
+
+        std::vector<int> coverers(jMasks.size(), 0);
+        for (size_t g : selected) {
+            for (size_t jIdx = 0; jIdx < jMasks.size(); ++jIdx) {
+                if (coversJ(g, jIdx)) coverers[jIdx]++;
+            }
+        }
+
+        for (size_t i = selected.size(); i-- > 0;) {
+            const size_t g = selected[i];
+            bool redundant = true;
+            for (size_t jIdx = 0; jIdx < jMasks.size() && redundant; ++jIdx) {
+                if (coversJ(g, jIdx) && coverers[jIdx] < 2) redundant = false;
+            }
+            if (!redundant) continue;
+            for (size_t jIdx = 0; jIdx < jMasks.size(); ++jIdx) {
+                if (coversJ(g, jIdx)) coverers[jIdx]--;
+            }
+            selected.erase(selected.begin() + i);
+        }
+        return selected;
+    }
+} // anonymous namespace
+
+std::vector<size_t> lazyGreedyCover(
+    const IncidenceMatrix& incidence,
+    const std::vector<CombinationMask>& groupMasks,
+    const std::vector<CombinationMask>& jMasks,
+    int s
+) {
+    Coverage coverage(incidence, groupMasks, jMasks, s);
+
+    // 初始增益即每个k组覆盖的j组数
+    std::vector<HeapEntry> entries;
+    entries.reserve(groupMasks.size());
+    for (size_t g = 0; g < groupMasks.size(); ++g) {
+        const size_t gain = incidence.empty() ? coverage.gain(g) : incidence.rowDegree(g);
+        if (gain > 0) entries.push_back({gain, g, 0});
+    }
+    std::priority_queue<HeapEntry> heap(std::less<HeapEntry>(), std::move(entries));
+
+    std::vector<size_t> selected;
+    while (coverage.uncoveredCount() > 0 && !heap.empty()) {
+        HeapEntry top = heap.top();
+        heap.pop();
+        if (top.round == selected.size()) {
+            selected.push_back(top.group);
+            coverage.add(top.group);
+            continue;
+        }
+        top.gain = coverage.gain(top.group);
+        top.round = selected.size();
+        if (top.gain > 0) heap.push(top);
+    }
+
+    if (coverage.uncoveredCount() > 0) return selected;
+    return removeRedundant(std::move(selected), incidence, groupMasks, jMasks, s);
+}
+
+} // namespace core_algo
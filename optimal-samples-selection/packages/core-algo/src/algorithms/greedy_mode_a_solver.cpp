@@ -0,0 +1,148 @@
+#include "mode_a_solver.hpp"
+#include "combination_generator.hpp"
+#include "set_operations.hpp"
+#include "coverage_calculator.hpp"
+#include "incidence_matrix.hpp"
+#include "greedy_cover.hpp"
+#include <chrono>
+
+namespace core_algo {
+
+namespace {
+    // 惰性贪心（CELF）：候选k组按边际增益（新覆盖的j组数）放入最大堆，见 lazyGreedyCover
+    class GreedyModeASolver : public ModeASolver {
+    private:
+        IncidenceMatrix buildIncidence(
+            const std::vector<CombinationMask>& groupMasks,
+            const std::vector<CombinationMask>& jMasks,
+            int j,
+            int s
+        ) const {
+            if (IncidenceMatrix::estimateBytes(groupMasks.size(), jMasks.size()) > m_config.maxCacheBytes) {
+                return IncidenceMatrix();
+            }
+            return IncidenceMatrix::forCoverage(groupMasks, jMasks, j, s, CoverageMode::CoverMinOneS, 1,
+                                                m_config.enableParallel ? m_config.threadCount : 1);
+        }
+
+        // 惰性贪心选择，返回选中k组的下标（按选中顺序）；无法覆盖全部j组时返回已选部分
+        std::vector<size_t> selectGreedy(
+            const std::vector<CombinationMask>& groupMasks,
+            const std::vector<CombinationMask>& jMasks,
+            int j,
+            int s
+        ) const {
+            return lazyGreedyCover(buildIncidence(groupMasks, jMasks, j, s), groupMasks, jMasks, s);
+        }
+
+        std::vector<std::vector<int>> toGroups(
+            const std::vector<size_t>& selected,
+            const std::vector<CombinationMask>& groupMasks
+        ) const {
+            std::vector<std::vector<int>> groups;
+            groups.reserve(selected.size());
+            for (size_t g : selected) {
+                groups.push_back(fromMask(groupMasks[g]));
+            }
+            return groups;
+        }
+
+    public:
+        GreedyModeASolver(
+            std::shared_ptr<CombinationGenerator> combGen,
+            std::shared_ptr<SetOperations> setOps,
+            std::shared_ptr<CoverageCalculator> covCalc,
+            const Config& config
+        ) : ModeASolver(config) {
+            m_combGen = combGen;
+            m_setOps = setOps;
+            m_covCalc = covCalc;
+        }
+
+    protected:
+        CombinationResult generateCombinations(
+            int m,
+            int n,
+            const std::vector<int>& samples,
+            int k,
+            int s,
+            int j
+        ) override {
+            // 贪心只需要k组与j组，不建立s子集映射
+            CombinationResult result;
+            result.groups = m_combGen->generate(samples, k);
+            result.jCombinations = m_combGen->generate(samples, j);
+
+            samples_ = samples;
+            jGroups_ = result.jCombinations;
+            candidates_ = result.groups;
+            return result;
+        }
+
+    public:
+        std::vector<std::vector<int>> performSelection(
+            const std::vector<std::vector<int>>& groups,
+            const std::vector<std::vector<int>>& jCombinations,
+            const std::vector<std::vector<int>>& sSubsets,
+            int j,
+            int s
+        ) const override {
+            const auto groupMasks = toMasks(groups);
+            return toGroups(selectGreedy(groupMasks, toMasks(jCombinations), j, s), groupMasks);
+        }
+
+        DetailedSolution solve(
+            int m,
+            int n,
+            const std::vector<int>& samples,
+            int k,
+            int s,
+            int j
+        ) override {
+            auto startTime = std::chrono::steady_clock::now();
+
+            // 直接生成位掩码，不经过向量形式的组合
+            const auto groupMasks = m_combGen->generateMasks(samples, k);
+            const auto jMasks = m_combGen->generateMasks(samples, j);
+            const auto selected = selectGreedy(groupMasks, jMasks, j, s);
+
+            std::vector<CombinationMask> selectedMasks;
+            selectedMasks.reserve(selected.size());
+            for (size_t g : selected) {
+                selectedMasks.push_back(groupMasks[g]);
+            }
+            auto coverageResult = m_covCalc->calculateCoverage(
+                selectedMasks, jMasks, s, CoverageMode::CoverMinOneS, 1, CoverageDetail::RatioOnly);
+
+            auto endTime = std::chrono::steady_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(endTime - startTime);
+
+            DetailedSolution solution;
+            solution.groups = toGroups(selected, groupMasks);
+            solution.coverageRatio = coverageResult.coverage_ratio;
+            solution.totalGroups = static_cast<int>(selected.size());
+            solution.computationTime = duration.count();
+            // 贪心解只是组数的上界，不保证最优
+            solution.isOptimal = false;
+            if (coverageResult.covered_j_count == coverageResult.total_j_count) {
+                solution.status = Status::Success;
+                solution.message = "Greedy Mode A solver completed successfully";
+            } else {
+                solution.status = Status::NoSolution;
+                solution.message = "Candidate groups cannot cover all j groups";
+            }
+            return solution;
+        }
+    };
+} // anonymous namespace
+
+std::shared_ptr<ModeASolver> createGreedyModeASolver(
+    std::shared_ptr<CombinationGenerator> combGen,
+    std::shared_ptr<SetOperations> setOps,
+    std::shared_ptr<CoverageCalculator> covCalc,
+    const Config& config
+) {
+    return std::make_shared<GreedyModeASolver>(combGen, setOps, covCalc, config);
+}
+
+} // namespace core_algo
@@ -0,0 +1,173 @@
+#include "incidence_matrix.hpp"
+#include "combinadic.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace core_algo {
+
+namespace {
+    size_t wordCount(size_t bits) {
+        return (bits + IncidenceMatrix::WORD_BITS - 1) / IncidenceMatrix::WORD_BITS;
+    }
+
+    // 在共享线程池中并行处理 [0, count)，每块至少 minChunk 个元素
+    template <typename Fn>
+    void parallelRanges(size_t count, int threadCount, size_t minChunk, Fn fn) {
+        if (count == 0) return;
+        const size_t threads = threadCount > 0
+            ? static_cast<size_t>(threadCount)
+            : std::max(1u, std::thread::hardware_concurrency());
+        auto pool = ThreadPool::shared(threads);
+        pool->parallelFor(0, count, fn, ThreadPool::chunkSize(count, pool->threadCount(), minChunk));
+    }
+
+    size_t popcountWords(const IncidenceMatrix::Word* words, size_t count) {
+        size_t total = 0;
+        for (size_t w = 0; w < count; ++w) {
+            total += __builtin_popcountll(words[w]);
+        }
+        return total;
+    }
+} // anonymous namespace
+
+void IncidenceMatrix::allocate(size_t rowCount, size_t columnCount) {
+    m_rowCount = rowCount;
+    m_columnCount = columnCount;
+    m_wordsPerRow = wordCount(columnCount);
+    m_wordsPerColumn = wordCount(rowCount);
+    m_rows.assign(m_rowCount * m_wordsPerRow, 0);
+    m_columns.assign(m_columnCount * m_wordsPerColumn, 0);
+}
+
+void IncidenceMatrix::buildColumns(int threadCount) {
+    // 按列的字块划分，每个线程只写入自己负责的列
+    parallelRanges(m_wordsPerRow, threadCount, 1, [this](size_t begin, size_t end) {
+        for (size_t r = 0; r < m_rowCount; ++r) {
+            const Word rowBit = Word(1) << (r % WORD_BITS);
+            const size_t rowWord = r / WORD_BITS;
+            for (size_t w = begin; w < end; ++w) {
+                Word bits = m_rows[r * m_wordsPerRow + w];
+                while (bits) {
+                    const size_t c = w * WORD_BITS + __builtin_ctzll(bits);
+                    m_columns[c * m_wordsPerColumn + rowWord] |= rowBit;
+                    bits &= bits - 1;
+                }
+            }
+        }
+    });
+}
+
+IncidenceMatrix IncidenceMatrix::build(
+    const std::vector<CombinationMask>& rows,
+    const std::vector<CombinationMask>& columns,
+    int minIntersection,
+    int threadCount
+) {
+    IncidenceMatrix matrix;
+    matrix.allocate(rows.size(), columns.size());
+
+    // 每行独占 wordsPerRow 个字，按行划分时各线程的写入互不重叠
+    parallelRanges(rows.size(), threadCount, 64, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            Word* out = matrix.m_rows.data() + r * matrix.m_wordsPerRow;
+            const CombinationMask rowMask = rows[r];
+            for (size_t c = 0; c < columns.size(); ++c) {
+                if (maskPopcount(rowMask & columns[c]) >= minIntersection) {
+                    out[c / WORD_BITS] |= Word(1) << (c % WORD_BITS);
+                }
+            }
+        }
+    });
+
+    matrix.buildColumns(threadCount);
+    return matrix;
+}
+
+IncidenceMatrix IncidenceMatrix::forCoverage(
+    const std::vector<CombinationMask>& kGroups,
+    const std::vector<CombinationMask>& jGroups,
+    int j,
+    int s,
+    CoverageMode mode,
+    int minCoverageCount,
+    int threadCount
+) {
+    return build(kGroups, jGroups, requiredIntersection(j, s, mode, minCoverageCount), threadCount);
+}
+
+IncidenceMatrix IncidenceMatrix::fromAdjacency(
+    const std::vector<std::vector<size_t>>& adjacency,
+    size_t columnCount
+) {
+    IncidenceMatrix matrix;
+    matrix.allocate(adjacency.size(), columnCount);
+    for (size_t r = 0; r < adjacency.size(); ++r) {
+        Word* out = matrix.m_rows.data() + r * matrix.m_wordsPerRow;
+        for (size_t c : adjacency[r]) {
+            if (c >= columnCount) {
+                throw AlgorithmError("关联矩阵的列下标越界");
+            }
+            out[c / WORD_BITS] |= Word(1) << (c % WORD_BITS);
+        }
+    }
+    matrix.buildColumns(0);
+    return matrix;
+}
+
+int IncidenceMatrix::requiredIntersection(int j, int s, CoverageMode mode, int minCoverageCount) {
+    switch (mode) {
+        case CoverageMode::CoverMinOneS:
+            return s;
+        case CoverageMode::CoverMinNS:
+            // 交集为 t 时单个k组覆盖 C(t, s) 个s子集
+            for (int t = s; t <= j; ++t) {
+                if (binomial(t, s) >= static_cast<size_t>(std::max(1, minCoverageCount))) {
+                    return t;
+                }
+            }
+            return j + 1;
+        case CoverageMode::CoverAllS:
+            return j;
+        default:
+            throw AlgorithmError("未知的覆盖模式");
+    }
+}
+
+size_t IncidenceMatrix::estimateBytes(size_t rowCount, size_t columnCount) {
+    return (rowCount * wordCount(columnCount) + columnCount * wordCount(rowCount)) * sizeof(Word);
+}
+
+size_t IncidenceMatrix::rowDegree(size_t r) const {
+    return popcountWords(row(r), m_wordsPerRow);
+}
+
+size_t IncidenceMatrix::columnDegree(size_t c) const {
+    return popcountWords(column(c), m_wordsPerColumn);
+}
+
+size_t IncidenceMatrix::countUncovered(size_t r, const Word* covered) const {
+    const Word* bits = row(r);
+    size_t total = 0;
+    for (size_t w = 0; w < m_wordsPerRow; ++w) {
+        total += __builtin_popcountll(bits[w] & ~covered[w]);
+    }
+    return total;
+}
+
+void IncidenceMatrix::mergeRow(size_t r, Word* covered) const {
+    const Word* bits = row(r);
+    for (size_t w = 0; w < m_wordsPerRow; ++w) {
+        covered[w] |= bits[w];
+    }
+}
+
+std::vector<IncidenceMatrix::Word> IncidenceMatrix::coveredColumns(const std::vector<size_t>& rows) const {
+    std::vector<Word> covered(m_wordsPerRow, 0);
+    for (size_t r : rows) {
+        mergeRow(r, covered.data());
+    }
+    return covered;
+}
+
+} // namespace core_algo
@@ -3,15 +3,33 @@
 #include "set_operations.hpp"
 #include "coverage_calculator.hpp"
 #include "preprocessor.hpp"
+#include "combinadic.hpp"
+#include "combination_visitor.hpp"
+#include "incidence_matrix.hpp"
+#include "thread_pool.hpp"
 #include <algorithm>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_set>
 #include <iostream>
-#include <string>
 
 namespace core_algo {
 
+namespace {
+    // k组覆盖的s子集集合（升序下标）的哈希
+    struct CoveredSubsetsHash {
+        size_t operator()(const std::vector<size_t>& indices) const {
+            size_t hash = indices.size();
+            for (size_t index : indices) {
+                hash ^= std::hash<size_t>()(index) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+} // anonymous namespace
+
 class ModeASetCoverSolverImpl : public ModeASolver {
 private:
     std::shared_ptr<CombinationGenerator> m_combGen;
@@ -29,7 +47,7 @@ public:
         m_combGen = combGen;
         m_setOps = setOps;
         m_covCalc = covCalc;
-        m_preprocessor = std::make_shared<Preprocessor>(combGen, setOps);
+        m_preprocessor = std::make_shared<Preprocessor>(combGen, setOps, config);
     }
 
 protected:
@@ -48,22 +66,19 @@ protected:
         result.jCombinations = m_combGen->generate(samples, j);   // j组集合
         result.allSSubsets = m_combGen->generate(samples, s);     // s子集集合
         
-        // 建立映射关系
-        for (const auto& jGroup : result.jCombinations) {
-            auto sSubsetsForJ = m_combGen->generate(jGroup, s);
-            result.jToSMap[jGroup] = sSubsetsForJ;
-            
-            for (const auto& sSubset : sSubsetsForJ) {
-                result.sToJMap[sSubset].push_back(jGroup);
-            }
-        }
+        // 按组合数下标索引的稠密映射；按向量索引的映射由预处理器在需要时构建
+        CombinadicRanker ranker(samples);
+        buildRankAdjacency(ranker, j, s, result.jToSRanks, result.sToJRanks);
         
         // 保存到求解器成员变量中
+        samples_ = samples;
         jGroups_ = result.jCombinations;
         candidates_ = result.groups;
         allSSubsets_ = result.allSSubsets;
         jToSMap_ = result.jToSMap;
         sToJMap_ = result.sToJMap;
+        jToSRanks_ = result.jToSRanks;
+        sToJRanks_ = result.sToJRanks;
         
         return result;
     }
@@ -86,40 +101,106 @@ protected:
         std::cout << "- s子集数量: " << sSubsets.size() << std::endl;
         std::cout << "- Beam宽度: " << BEAM_WIDTH << std::endl;
         
+        // 位掩码表示：子集检查为一次按位与比较
+        const auto sMasks = toMasks(sSubsets);
+        
+        // 组合数下标：用于在稠密映射中直接定位j组与s子集
+        const CombinadicRanker ranker(samples_);
+        std::vector<size_t> sRanks;
+        sRanks.reserve(sSubsets.size());
+        for (CombinationMask sMask : sMasks) {
+            sRanks.push_back(ranker.rank(sMask));
+        }
+        
+        // s子集组合数下标 -> sSubsets 中的下标（不在其中为 -1）
+        std::vector<int> sIndexByRank(ranker.count(s), -1);
+        for (size_t i = 0; i < sRanks.size(); ++i) {
+            sIndexByRank[sRanks[i]] = static_cast<int>(i);
+        }
+        
         // 预处理：筛选k组
         std::vector<std::vector<int>> groups;
-        std::map<std::vector<std::vector<int>>, int> coverageCount;  // 记录每个k组覆盖的s子集数量
+        std::vector<CombinationMask> groupMasks;
+        // 已保留k组覆盖的s子集集合（升序的s子集下标），覆盖完全相同的k组只保留第一个
+        std::unordered_set<std::vector<size_t>, CoveredSubsetsHash> coveredSets;
         
-        for (const auto& group : originalGroups) {
-            int coverCount = 0;
-            std::set<std::vector<int>> coveredS;
-            
-            // 计算该k组覆盖了多少个s子集
-            for (const auto& sSubset : sSubsets) {
-                if (m_setOps->contains(group, sSubset)) {
-                    coverCount++;
-                    coveredS.insert(sSubset);
+        // 候选集为全部k组时，按旋转门顺序预先计算每个k组覆盖的s子集数：
+        // 相邻k组只交换一个元素，只需检查包含换出/换入元素的s子集
+        std::vector<int> coverCountByRank;
+        const int k = originalGroups.empty() ? 0 : static_cast<int>(originalGroups.front().size());
+        if (k > 0 && originalGroups.size() == ranker.count(k)) {
+            std::vector<std::vector<size_t>> sByElement(MAX_MASK_VALUE + 1);
+            for (size_t i = 0; i < sSubsets.size(); ++i) {
+                for (int elem : sSubsets[i]) {
+                    sByElement[elem].push_back(i);
                 }
             }
             
+            coverCountByRank.assign(originalGroups.size(), 0);
+            CombinationMask previous = 0;
+            int count = 0;
+            forEachCombinationRevolvingDoor(samples_, k,
+                [&](CombinationView group, const CombinationSwap* swap) {
+                    CombinationMask current = 0;
+                    for (int elem : group) {
+                        current |= elementBit(elem);
+                    }
+                    if (!swap) {
+                        for (CombinationMask sMask : sMasks) {
+                            if (isSubmask(current, sMask)) count++;
+                        }
+                    } else {
+                        for (size_t i : sByElement[swap->removed]) {
+                            if (isSubmask(previous, sMasks[i])) count--;
+                        }
+                        for (size_t i : sByElement[swap->added]) {
+                            if (isSubmask(current, sMasks[i])) count++;
+                        }
+                    }
+                    coverCountByRank[ranker.rank(current)] = count;
+                    previous = current;
+                });
+        }
+        
+        std::vector<size_t> coveredS;
+        for (const auto& group : originalGroups) {
+            const CombinationMask groupMask = toMask(group);
+            
+            // 覆盖数已知且不超过1时无需枚举
+            if (!coverCountByRank.empty() && coverCountByRank[ranker.rank(groupMask)] <= 1) continue;
+            
+            // 枚举该k组的 C(k, s) 个s子集，按组合数下标查出其中属于 sSubsets 的
+            coveredS.clear();
+            forEachSubmaskOfSize(groupMask, s, [&](CombinationMask sMask) {
+                const int index = sIndexByRank[ranker.rank(sMask)];
+                if (index >= 0) coveredS.push_back(static_cast<size_t>(index));
+                return true;
+            });
+            
             // 如果只覆盖1个或更少的s子集，直接跳过
-            if (coverCount <= 1) continue;
+            if (coveredS.size() <= 1) continue;
             
             // 检查是否与已有组覆盖完全相同
-            bool isDuplicate = false;
-            for (const auto& [existingCovered, count] : coverageCount) {
-                if (coveredS == std::set<std::vector<int>>(existingCovered.begin(), existingCovered.end())) {
-                    isDuplicate = true;
-                    break;
-                }
-            }
-            
-            if (!isDuplicate) {
+            std::sort(coveredS.begin(), coveredS.end());
+            if (coveredSets.insert(coveredS).second) {
                 groups.push_back(group);
-                coverageCount[std::vector<std::vector<int>>(coveredS.begin(), coveredS.end())] = coverCount;
+                groupMasks.push_back(groupMask);
             }
         }
         
+        // k组 × j组关联矩阵：k组覆盖j组的某个s子集当且仅当 |k∩j| >= s
+        // 超出内存预算时退化为逐对的交集计数
+        const auto jMasks = toMasks(jCombinations);
+        IncidenceMatrix incidence;
+        if (IncidenceMatrix::estimateBytes(groups.size(), jMasks.size()) <= m_config.maxCacheBytes) {
+            incidence = IncidenceMatrix::forCoverage(groupMasks, jMasks, j, s, CoverageMode::CoverMinOneS, 1,
+                                                     m_config.enableParallel ? m_config.threadCount : 1);
+        }
+        auto groupCoversJ = [&](size_t g, size_t jIdx) {
+            if (!incidence.empty()) return incidence.covers(g, jIdx);
+            return maskPopcount(groupMasks[g] & jMasks[jIdx]) >= s;
+        };
+        
         // 1. 分析s子集中元素的频率
         std::map<int, int> elementFrequency;
         std::map<int, std::vector<int>> elementToSSubsets;  // 元素到包含它的s子集的映射
@@ -130,36 +211,114 @@ protected:
             }
         }
         
-        // 候选状态结构
+        // 候选状态结构：覆盖状态按位集保存，已选k组为掩码数组
         struct State {
-            std::vector<std::vector<int>> selectedGroups;  // 已选择的k组
-            std::set<int> coveredSSubsets;                 // 已覆盖的s子集索引
-            std::map<std::string, int> jCoverage;          // j组覆盖次数 (使用string作为key)
-            double score;                                  // 状态得分
+            std::vector<CombinationMask> selectedGroups;  // 已选择的k组
+            DynamicBitset coveredSSubsets;                // 已覆盖的s子集
+            DynamicBitset coveredJ;                       // 已选k组覆盖的j组（|k∩j| >= s）
+            size_t coveredSCount = 0;
+            size_t coveredJCount = 0;
+            size_t countedJCount = 0;                     // 评分中视为已覆盖的j组数（初始状态为0）
+            std::vector<double> similaritySum;            // 每个s子集与已覆盖s子集的Jaccard相似度之和
+            double pairSimilarity = 0.0;                  // 已覆盖s子集两两之间的Jaccard相似度之和
+            double score = 0.0;                           // 状态得分
+        };
+        
+        // 扩展候选：父状态下标 + 新增k组下标，评分由父状态的增量算出；
+        // 只有进入下一轮beam的候选才生成完整状态
+        struct Candidate {
+            size_t parent;
+            size_t group;
+            size_t coveredSCount;
+            double score;
+        };
+        
+        // 评分相同时按父状态、k组下标排序，使结果与扩展顺序无关
+        auto isBetter = [](const Candidate& a, const Candidate& b) {
+            if (a.score != b.score) return a.score > b.score;
+            if (a.parent != b.parent) return a.parent < b.parent;
+            return a.group < b.group;
+        };
+        
+        auto similarity = [&](size_t a, size_t b) {
+            return static_cast<double>(maskPopcount(sMasks[a] & sMasks[b])) / maskPopcount(sMasks[a] | sMasks[b]);
+        };
+        
+        // 该k组包含、且不在 covered 中的s子集：枚举k组的 C(k, s) 个s子集，无需扫描全部s子集
+        auto collectNewS = [&](CombinationMask groupMask, const DynamicBitset& covered, std::vector<size_t>& newS) {
+            newS.clear();
+            forEachSubmaskOfSize(groupMask, s, [&](CombinationMask sMask) {
+                const int i = sIndexByRank[ranker.rank(sMask)];
+                if (i >= 0 && !covered[i]) newS.push_back(i);
+                return true;
+            });
+        };
+        
+        // 新增s子集带来的相似度：与已覆盖s子集之间（cross）及新增s子集两两之间（among）
+        auto newSimilarity = [&](const State& state, const std::vector<size_t>& newS, double& cross, double& among) {
+            cross = 0.0;
+            among = 0.0;
+            for (size_t a = 0; a < newS.size(); ++a) {
+                cross += state.similaritySum[newS[a]];
+                for (size_t b = a + 1; b < newS.size(); ++b) {
+                    among += similarity(newS[a], newS[b]);
+                }
+            }
+        };
+        
+        // 把k组加入状态：更新s子集与j组覆盖位集和相似度
+        auto addGroup = [&](State& state, CombinationMask groupMask, size_t g, std::vector<size_t>& newS) {
+            collectNewS(groupMask, state.coveredSSubsets, newS);
+            double cross, among;
+            newSimilarity(state, newS, cross, among);
+            state.pairSimilarity += cross + among;
+            for (size_t c : newS) {
+                state.coveredSSubsets.set(c);
+                for (size_t i = 0; i < sSubsets.size(); ++i) {
+                    if (i != c) state.similaritySum[i] += similarity(i, c);
+                }
+            }
+            state.coveredSCount += newS.size();
             
-            bool operator<(const State& other) const {
-                return score < other.score;
+            if (g < groups.size() && !incidence.empty()) {
+                incidence.mergeRow(g, state.coveredJ.words());
+            } else {
+                for (size_t jIdx = 0; jIdx < jMasks.size(); ++jIdx) {
+                    if (maskPopcount(groupMask & jMasks[jIdx]) >= s) state.coveredJ.set(jIdx);
+                }
             }
+            state.coveredJCount = state.coveredJ.count();
+            state.selectedGroups.push_back(groupMask);
         };
         
-        // 辅助函数：将 jGroup 转成 string 作为 map key
-        auto vecToStr = [](const std::vector<int>& vec) {
-            std::string key;
-            for (int val : vec) {
-                key += std::to_string(val) + ",";
+        auto emptyState = [&]() {
+            State state;
+            state.coveredSSubsets = DynamicBitset(sSubsets.size());
+            state.coveredJ = DynamicBitset(jMasks.size());
+            state.similaritySum.assign(sSubsets.size(), 0.0);
+            return state;
+        };
+        
+        auto toGroups = [](const std::vector<CombinationMask>& masks) {
+            std::vector<std::vector<int>> result;
+            result.reserve(masks.size());
+            for (CombinationMask mask : masks) {
+                result.push_back(fromMask(mask));
             }
-            return key;
+            return result;
         };
         
+        std::vector<size_t> newS;
+        
         // 初始化beam：使用Warm Start
         std::vector<State> beam;
         
         // 改进Warm Start策略：找到覆盖最多j组的s子集
         std::map<std::vector<int>, int> sToJCount;
-        for (const auto& s : sSubsets) {
-            auto it = sToJMap_.find(s);
-            if (it != sToJMap_.end()) {
-                sToJCount[s] = it->second.size();
+        for (size_t i = 0; i < sSubsets.size(); ++i) {
+            const auto& coveredJ = sToJRanks_[sRanks[i]];
+            if (!coveredJ.empty()) {
+                sToJCount[sSubsets[i]] = coveredJ.size();
             }
         }
         
@@ -168,24 +327,12 @@ protected:
 
         // 使用覆盖最多j组的s子集对应的k组作为warm start
         if (maxSJ != sToJCount.end()) {
-            for (const auto& group : groups) {
-                if (m_setOps->contains(group, maxSJ->first)) {
-                    State warmStartState{{}, {}, {}, 0.0};
-                    warmStartState.selectedGroups.push_back(group);
-                    
-                    // 更新覆盖信息
-                    for (size_t i = 0; i < sSubsets.size(); ++i) {
-                        if (m_setOps->contains(group, sSubsets[i])) {
-                            warmStartState.coveredSSubsets.insert(i);
-                        }
-                    }
-                    
-                    // 初始化j组覆盖
-                    for (const auto& j : jCombinations) {
-                        warmStartState.jCoverage[vecToStr(j)] = 0;
-                    }
-                    
-                    beam.push_back(warmStartState);
+            const CombinationMask maxSJMask = toMask(maxSJ->first);
+            for (size_t g = 0; g < groups.size(); ++g) {
+                if (m_setOps->contains(groupMasks[g], maxSJMask)) {
+                    State warmStartState = emptyState();
+                    addGroup(warmStartState, groupMasks[g], g, newS);
+                    beam.push_back(std::move(warmStartState));
                     break;
                 }
             }
@@ -204,274 +351,227 @@ protected:
         }
         
         // 初始化beam with warm start
-        State initialState1{{}, {}, {}, 0.0};
+        State initialState1 = emptyState();
         if (!centralGroup.empty()) {
-            initialState1.selectedGroups.push_back(centralGroup);
+            addGroup(initialState1, toMask(centralGroup), groups.size(), newS);
         }
+        beam.push_back(std::move(initialState1));
         
-        beam.push_back(initialState1);
-        
-        // 更新初始状态的覆盖信息
+        // 初始状态的j组覆盖不计入评分，与逐个扩展时的计数方式一致
         for (auto& state : beam) {
-            for (const auto& group : state.selectedGroups) {
-                for (size_t i = 0; i < sSubsets.size(); ++i) {
-                    if (m_setOps->contains(group, sSubsets[i])) {
-                        state.coveredSSubsets.insert(i);
-                    }
+            state.countedJCount = 0;
+        }
+        
+        // 父状态 p 加入第 g 个k组后的评分，只由父状态与增量算出
+        auto evaluate = [&](const State& state, size_t p, size_t g, std::vector<size_t>& newS) {
+            const size_t selectedCount = state.selectedGroups.size() + 1;
+            
+            // 这个k组新覆盖的s子集及相似度增量
+            collectNewS(groupMasks[g], state.coveredSSubsets, newS);
+            double cross, among;
+            newSimilarity(state, newS, cross, among);
+            const size_t coveredSCount = state.coveredSCount + newS.size();
+            
+            // 新覆盖的j组：已选k组未覆盖、而该k组覆盖的j组
+            size_t coveredJCount = state.coveredJCount;
+            if (!incidence.empty()) {
+                coveredJCount += incidence.countUncovered(g, state.coveredJ.words());
+            } else {
+                for (size_t jIdx = 0; jIdx < jMasks.size(); ++jIdx) {
+                    if (!state.coveredJ[jIdx] && groupCoversJ(g, jIdx)) coveredJCount++;
                 }
             }
-            // 初始化j组覆盖
-            for (const auto& j : jCombinations) {
-                state.jCoverage[vecToStr(j)] = 0;
+            const size_t newlyCoveredJ = coveredJCount - state.countedJCount;
+            const size_t uncoveredJCount = jMasks.size() - coveredJCount;
+            
+            // 更新评分函数
+            double coverageRatio = static_cast<double>(coveredSCount) / sSubsets.size();
+            double jCoverageRatio = static_cast<double>(coveredJCount) / jCombinations.size();
+            
+            // 多样性得分：新旧s子集之间的相似度与全部已覆盖s子集两两之间的相似度
+            double diversityScore = 1.0;
+            if (coveredSCount > 1) {
+                const double pairSimilarity = state.pairSimilarity + cross + among;
+                const double comparisons = static_cast<double>(coveredSCount) * (coveredSCount - 1) / 2;
+                diversityScore = 1.0 - ((cross + pairSimilarity) / comparisons);
             }
-        }
+            
+            // 计算新状态的评分
+            Candidate candidate{p, g, coveredSCount, 0.0};
+            candidate.score = 
+                coverageRatio * 100 +                // s子集覆盖率
+                jCoverageRatio * 200 +              // j组覆盖率（加大权重）
+                newlyCoveredJ * 50.0 +              // 新覆盖的j组数量
+                newS.size() * 30.0 +                // 新覆盖的s子集数量
+                diversityScore * 20 -               // 多样性得分
+                std::abs(static_cast<double>(3 - static_cast<int>(selectedCount))) * 30;  // 组数接近3的奖励
+
+            // 如果已经选择了3个组但仍有未覆盖的j组，显著降低评分
+            if (selectedCount >= 3 && uncoveredJCount > 0) {
+                candidate.score -= uncoveredJCount * 100.0;  // 每个未覆盖的j组都会降低评分
+            }
+            return candidate;
+        };
+        
+        // 保留得分最高的 BEAM_WIDTH 个候选，堆顶为其中最差的一个
+        auto keepTop = [&](std::vector<Candidate>& top, const Candidate& candidate) {
+            if (top.size() < static_cast<size_t>(BEAM_WIDTH)) {
+                top.push_back(candidate);
+                std::push_heap(top.begin(), top.end(), isBetter);
+            } else if (isBetter(candidate, top.front())) {
+                std::pop_heap(top.begin(), top.end(), isBetter);
+                top.back() = candidate;
+                std::push_heap(top.begin(), top.end(), isBetter);
+            }
+        };
+        
+        // 最佳解的比较：覆盖的s子集数优先，其次评分；相同时先扩展到的（父状态、k组下标较小）优先
+        auto isBetterSolution = [](const Candidate& a, const Candidate& b) {
+            if (a.coveredSCount != b.coveredSCount) return a.coveredSCount > b.coveredSCount;
+            if (a.score != b.score) return a.score > b.score;
+            if (a.parent != b.parent) return a.parent < b.parent;
+            return a.group < b.group;
+        };
+        
+        // 扩展在共享线程池中按k组分块并行：每块维护自己的前 BEAM_WIDTH 个候选与最佳候选，
+        // 结束时合并到本轮结果中；比较均为全序，合并结果与分块方式和完成顺序无关
+        auto pool = ThreadPool::forConfig(m_config);
+        std::mutex mergeMutex;
         
         // 记录最佳解
-        State bestState = beam[0];
+        std::vector<CombinationMask> bestSelected = beam[0].selectedGroups;
         double bestScore = 0.0;
-        int bestCoveredCount = 0;
+        size_t bestCoveredCount = 0;
         
         // 迭代构建解
         for (int iter = 0; iter < MAX_ITERATIONS && !beam.empty(); ++iter) {
             std::cout << "\n迭代 " << iter + 1 << ":" << std::endl;
             std::cout << "当前beam大小: " << beam.size() << std::endl;
             
-            std::vector<State> candidates;
+            std::vector<Candidate> top;
+            size_t candidateCount = 0;
+            bool bestChanged = false;
+            Candidate bestCandidate{};
             
             // 对beam中的每个状态扩展
-            for (const auto& state : beam) {
+            for (size_t p = 0; p < beam.size(); ++p) {
+                const State& state = beam[p];
                 std::cout << "处理状态 - 已选组数: " << state.selectedGroups.size() 
-                         << ", 已覆盖s子集数: " << state.coveredSSubsets.size() << std::endl;
+                         << ", 已覆盖s子集数: " << state.coveredSCount << std::endl;
                 
                 // 检查是否所有s子集都被覆盖
-                if (state.coveredSSubsets.size() == sSubsets.size()) {
+                if (state.coveredSCount == sSubsets.size()) {
                     std::cout << "找到完全覆盖解!" << std::endl;
-                    return state.selectedGroups;
+                    return toGroups(state.selectedGroups);
                 }
                 
-                int candidatesBeforeThisState = candidates.size();
+                const size_t candidatesBeforeThisState = candidateCount;
                 
                 // 构造候选k组
-                for (const auto& group : groups) {
-                    // 跳过已选的组
-                    if (std::find(state.selectedGroups.begin(), 
-                                state.selectedGroups.end(), group) != state.selectedGroups.end()) {
-                        continue;
-                    }
-                    
-                    // 创建新状态
-                    State newState = state;
-                    newState.selectedGroups.push_back(group);
+                pool->parallelFor(0, groups.size(), [&](size_t begin, size_t end) {
+                    std::vector<size_t> localNewS;
+                    std::vector<Candidate> localTop;
+                    size_t localCount = 0;
+                    bool localBestFound = false;
+                    Candidate localBest{};
                     
-                    // 计算这个k组能覆盖哪些s子集
-                    int newlyCoveredS = 0;
-                    std::set<int> commonElements;
-                    double jaccardSum = 0.0;
-                    
-                    for (size_t i = 0; i < sSubsets.size(); ++i) {
-                        if (state.coveredSSubsets.count(i) > 0) continue;
-                        
-                        if (m_setOps->contains(group, sSubsets[i])) {
-                            newState.coveredSSubsets.insert(i);
-                            newlyCoveredS++;
-                            
-                            // 更新j组覆盖
-                            auto it = sToJMap_.find(sSubsets[i]);
-                            if (it != sToJMap_.end()) {
-                                for (const auto& j : it->second) {
-                                    newState.jCoverage[vecToStr(j)]++;
-                                }
-                            }
-                            
-                            // 计算与其他已覆盖s子集的Jaccard相似度
-                            for (int coveredIdx : state.coveredSSubsets) {
-                                jaccardSum += m_setOps->calculateJaccardSimilarity(sSubsets[i], sSubsets[coveredIdx]);
-                            }
-                            
-                            // 收集公共元素
-                            if (commonElements.empty()) {
-                                commonElements.insert(sSubsets[i].begin(), sSubsets[i].end());
-                            } else {
-                                std::set<int> intersection;
-                                std::set<int> current(sSubsets[i].begin(), sSubsets[i].end());
-                                std::set_intersection(
-                                    commonElements.begin(), commonElements.end(),
-                                    current.begin(), current.end(),
-                                    std::inserter(intersection, intersection.begin())
-                                );
-                                commonElements = intersection;
-                            }
-                        }
-                    }
-
-                    std::cout << "  尝试添加组 - 新覆盖s子集数: " << newlyCoveredS;
-
-                    // 计算新覆盖的j组数量
-                    int newlyCoveredJ = 0;
-                    
-                    // 遍历所有j组
-                    for (const auto& jGroup : jCombinations) {
-                        std::string jKey = vecToStr(jGroup);
-                        
-                        // 如果这个j组已经被覆盖，跳过
-                        auto coverageIt = state.jCoverage.find(jKey);
-                        if (coverageIt != state.jCoverage.end() && coverageIt->second > 0) {
-                            continue;
-                        }
-                        
-                        // 检查j组的每个s子集是否被覆盖
-                        auto jToSIt = jToSMap_.find(jGroup);
-                        if (jToSIt == jToSMap_.end()) {
+                    for (size_t g = begin; g < end; ++g) {
+                        // 跳过已选的组
+                        if (std::find(state.selectedGroups.begin(), state.selectedGroups.end(), groupMasks[g])
+                                != state.selectedGroups.end()) {
                             continue;
                         }
                         
-                        bool isJGroupCovered = false;
-                        for (const auto& s : jToSIt->second) {
-                            // 检查新组是否覆盖这个s子集
-                            if (m_setOps->contains(group, s)) {
-                                isJGroupCovered = true;
-                                break;
-                            }
-                            
-                            // 检查已有组是否覆盖这个s子集
-                            for (const auto& existingGroup : state.selectedGroups) {
-                                if (m_setOps->contains(existingGroup, s)) {
-                                    isJGroupCovered = true;
-                                    break;
-                                }
-                            }
-                            if (isJGroupCovered) break;
-                        }
+                        const Candidate candidate = evaluate(state, p, g, localNewS);
+                        localCount++;
+                        keepTop(localTop, candidate);
                         
-                        if (isJGroupCovered) {
-                            newlyCoveredJ++;
-                            newState.jCoverage[jKey] = 1;
-                        }
-                    }
-
-                    // 检查是否所有j组都被覆盖
-                    bool allJCovered = true;
-                    int uncoveredJCount = 0;
-                    for (const auto& jGroup : jCombinations) {
-                        std::string jKey = vecToStr(jGroup);
-                        auto it = newState.jCoverage.find(jKey);
-                        if (it == newState.jCoverage.end() || it->second == 0) {
-                            allJCovered = false;
-                            uncoveredJCount++;
-                        }
-                    }
-
-                    // 更新评分函数
-                    double coverageRatio = static_cast<double>(newState.coveredSSubsets.size()) / sSubsets.size();
-                    double jCoverageRatio = static_cast<double>(jCombinations.size() - uncoveredJCount) / jCombinations.size();
-                    
-                    // 计算多样性得分 - 重用之前的jaccardSum变量
-                    double diversityScore = 1.0;
-                    if (newState.coveredSSubsets.size() > 1) {
-                        int comparisons = 0;
-                        for (auto it1 = newState.coveredSSubsets.begin(); it1 != newState.coveredSSubsets.end(); ++it1) {
-                            auto it2 = it1;
-                            ++it2;
-                            for (; it2 != newState.coveredSSubsets.end(); ++it2) {
-                                jaccardSum += m_setOps->calculateJaccardSimilarity(sSubsets[*it1], sSubsets[*it2]);
-                                comparisons++;
+                        // 本轮开始时的最佳解不随扩展变化，只读访问
+                        if (candidate.coveredSCount > bestCoveredCount || 
+                            (candidate.coveredSCount == bestCoveredCount && candidate.score > bestScore)) {
+                            if (!localBestFound || isBetterSolution(candidate, localBest)) {
+                                localBest = candidate;
+                                localBestFound = true;
                             }
                         }
-                        if (comparisons > 0) {
-                            diversityScore = 1.0 - (jaccardSum / comparisons);
-                        }
                     }
                     
-                    // 计算新状态的评分
-                    newState.score = 
-                        coverageRatio * 100 +                // s子集覆盖率
-                        jCoverageRatio * 200 +              // j组覆盖率（加大权重）
-                        newlyCoveredJ * 50 +                // 新覆盖的j组数量
-                        newlyCoveredS * 30 +                // 新覆盖的s子集数量
-                        diversityScore * 20 -               // 多样性得分
-                        std::abs(static_cast<double>(3 - static_cast<int>(newState.selectedGroups.size()))) * 30;  // 组数接近3的奖励
-
-                    // 如果已经选择了3个组但仍有未覆盖的j组，显著降低评分
-                    if (newState.selectedGroups.size() >= 3 && !allJCovered) {
-                        newState.score -= uncoveredJCount * 100;  // 每个未覆盖的j组都会降低评分
+                    std::lock_guard<std::mutex> lock(mergeMutex);
+                    candidateCount += localCount;
+                    for (const auto& candidate : localTop) {
+                        keepTop(top, candidate);
                     }
-
-                    // 添加详细的调试信息
-                    std::cout << "  状态评估:" << std::endl;
-                    std::cout << "    - 已选组数: " << newState.selectedGroups.size() << std::endl;
-                    std::cout << "    - s子集覆盖率: " << (coverageRatio * 100) << "%" << std::endl;
-                    std::cout << "    - j组覆盖率: " << (jCoverageRatio * 100) << "%" << std::endl;
-                    std::cout << "    - 未覆盖j组数: " << uncoveredJCount << std::endl;
-                    std::cout << "    - 新覆盖j组数: " << newlyCoveredJ << std::endl;
-                    std::cout << "    - 新覆盖s子集数: " << newlyCoveredS << std::endl;
-                    std::cout << "    - 多样性得分: " << diversityScore << std::endl;
-                    std::cout << "    - 最终评分: " << newState.score << std::endl;
-
-                    candidates.push_back(newState);
-                    
-                    // 更新最佳解
-                    if (newState.coveredSSubsets.size() > bestCoveredCount || 
-                        (newState.coveredSSubsets.size() == bestCoveredCount && 
-                         newState.score > bestScore)) {
-                        bestScore = newState.score;
-                        bestState = newState;
-                        bestCoveredCount = newState.coveredSSubsets.size();
+                    if (localBestFound && (!bestChanged || isBetterSolution(localBest, bestCandidate))) {
+                        bestCandidate = localBest;
+                        bestChanged = true;
                     }
-                }
+                }, ThreadPool::chunkSize(groups.size(), pool->threadCount(), 256));
                 
-                std::cout << "本状态产生的新候选数: " << (candidates.size() - candidatesBeforeThisState) << std::endl;
+                std::cout << "本状态产生的新候选数: " << (candidateCount - candidatesBeforeThisState) << std::endl;
+            }
+            
+            // 本轮的最佳候选
+            if (bestChanged) {
+                bestScore = bestCandidate.score;
+                bestCoveredCount = bestCandidate.coveredSCount;
             }
             
-            std::cout << "本轮产生的总候选数: " << candidates.size() << std::endl;
+            std::cout << "本轮产生的总候选数: " << candidateCount << std::endl;
             
             // 如果没有新的候选状态，终止搜索
-            if (candidates.empty()) {
+            if (candidateCount == 0) {
                 std::cout << "没有新的候选状态，终止搜索" << std::endl;
                 break;
             }
             
-            // 选择最好的BEAM_WIDTH个状态
-            std::sort(candidates.begin(), candidates.end(), 
-                     [](const State& a, const State& b) { return a.score > b.score; });
-            
-            beam.clear();
-            for (size_t i = 0; i < std::min(static_cast<size_t>(BEAM_WIDTH), candidates.size()); ++i) {
-                beam.push_back(candidates[i]);
+            // 最佳候选的已选k组由父状态得到，需在beam被替换前取出
+            std::sort_heap(top.begin(), top.end(), isBetter);
+            auto selectedOf = [&](const Candidate& candidate) {
+                auto selected = beam[candidate.parent].selectedGroups;
+                selected.push_back(groupMasks[candidate.group]);
+                return selected;
+            };
+            if (bestChanged) {
+                bestSelected = selectedOf(bestCandidate);
             }
             
-            std::cout << "更新后的beam大小: " << beam.size() << std::endl;
-            
             // 更新最佳解
-            if (!candidates.empty() && 
-                (candidates[0].coveredSSubsets.size() > bestCoveredCount || 
-                 (candidates[0].coveredSSubsets.size() == bestCoveredCount && 
-                  candidates[0].score > bestScore))) {
-                bestScore = candidates[0].score;
-                bestState = candidates[0];
-                bestCoveredCount = candidates[0].coveredSSubsets.size();
+            if (top[0].coveredSCount > bestCoveredCount || 
+                (top[0].coveredSCount == bestCoveredCount && top[0].score > bestScore)) {
+                bestScore = top[0].score;
+                bestSelected = selectedOf(top[0]);
+                bestCoveredCount = top[0].coveredSCount;
                 std::cout << "更新最佳解 - 覆盖数: " << bestCoveredCount 
                          << ", 分数: " << bestScore 
-                         << ", 组数: " << bestState.selectedGroups.size() << std::endl;
+                         << ", 组数: " << bestSelected.size() << std::endl;
+            }
+            
+            // 只为得分最高的BEAM_WIDTH个候选生成完整状态
+            std::vector<State> nextBeam;
+            nextBeam.reserve(top.size());
+            for (const auto& candidate : top) {
+                State child = beam[candidate.parent];
+                addGroup(child, groupMasks[candidate.group], candidate.group, newS);
+                child.countedJCount = child.coveredJCount;
+                child.score = candidate.score;
+                nextBeam.push_back(std::move(child));
             }
+            beam = std::move(nextBeam);
+            
+            std::cout << "更新后的beam大小: " << beam.size() << std::endl;
         }
         
         // Final check: ensure all j groups are covered
-        bool allJGroupsCoveredFinal = true;
-        for (const auto& jGroup : jCombinations) {
-            std::string jKey = vecToStr(jGroup);
-            if (bestState.jCoverage.find(jKey) == bestState.jCoverage.end() ||
-                bestState.jCoverage.at(jKey) == 0) {
-                allJGroupsCoveredFinal = false;
-                break;
-            }
-        }
+        // 直接按 |k∩j| >= s 判定，发现第一个未覆盖的j组即停止
+        const bool allJGroupsCoveredFinal = m_covCalc->isFeasible(
+            bestSelected, jMasks, s, CoverageMode::CoverMinOneS);
 
         if (!allJGroupsCoveredFinal) {
             std::cout << "[Error] Final solution does NOT cover all j groups!" << std::endl;
             return {};  // return empty to signal failure
         }
 
-        return bestState.selectedGroups;
+        return toGroups(bestSelected);
     }
 
     DetailedSolution solve(
@@ -504,6 +604,14 @@ protected:
         
         // 更新覆盖映射信息
         sToJMap_ = preprocessResult.selectedSToJMap;
+        CombinadicRanker ranker(samples);
+        sToJRanks_.assign(ranker.count(s), {});
+        for (const auto& [sSubset, coveredJ] : sToJMap_) {
+            auto& jRanks = sToJRanks_[ranker.rank(toMask(sSubset))];
+            for (const auto& jGroup : coveredJ) {
+                jRanks.push_back(ranker.rank(toMask(jGroup)));
+            }
+        }
         
         // 3. 执行选择过程，生成最终的k集合
         auto selectedGroups = performSelection(
@@ -515,20 +623,9 @@ protected:
         );
         
         // 4. 计算覆盖率
-        // 为每个j组合生成对应的s子集集合
-        std::vector<std::vector<std::vector<int>>> sSubsetsForJ;
-        for (const auto& jGroup : combinations.jCombinations) {
-            auto sSubsetsForThisJ = m_combGen->generate(jGroup, s);
-            sSubsetsForJ.push_back(sSubsetsForThisJ);
-        }
-        
-        auto coverageResult = m_covCalc->calculateCoverage(
-            selectedGroups,
-            combinations.jCombinations,
-            sSubsetsForJ,  // 使用正确的类型：每个j组合的s子集集合
-            CoverageMode::CoverMinOneS,
-            1  // 最小覆盖数为1
-        );
+        // Mode A 的覆盖判定为 |k∩j| >= s，j组合由样本直接枚举；这里只需要覆盖率
+        auto coverageResult = m_covCalc->calculateModeACoverage(
+            selectedGroups, samples, j, s, CoverageDetail::RatioOnly);
         
         // 5. 准备并返回最终解决方案
         auto endTime = std::chrono::steady_clock::now();
@@ -540,7 +637,8 @@ protected:
         solution.coverageRatio = coverageResult.coverage_ratio;
         solution.totalGroups = static_cast<int>(selectedGroups.size());
         solution.computationTime = duration.count();
-        solution.isOptimal = coverageResult.coverage_ratio >= 1.0;
+        // 束搜索不证明组数最少，覆盖全部j组并不意味着最优
+        solution.isOptimal = false;
         solution.message = "Mode A solver completed successfully";
         
         return solution;
@@ -1,6 +1,9 @@
 #include "preprocessor.hpp"
 #include "combination_generator.hpp"
 #include "set_operations.hpp"
+#include "combinadic.hpp"
+#include "combination_visitor.hpp"
+#include "incidence_matrix.hpp"
 #include <algorithm>
 #include <unordered_map>
 #include <cmath>
@@ -10,15 +13,57 @@
 
 namespace core_algo {
 
+namespace {
+    // j组 -> 其s子集
+    SubsetMap buildJToSMap(const std::vector<std::vector<int>>& jGroups, int s) {
+        SubsetMap jToSMap;
+        for (const auto& jGroup : jGroups) {
+            auto& sSubsetsForJ = jToSMap[jGroup];
+            forEachCombination(jGroup, s, [&](CombinationView sSubset) {
+                sSubsetsForJ.push_back(sSubset.toVector());
+            });
+        }
+        return jToSMap;
+    }
+
+    // s子集 -> 包含它的j组，由j组列表逐个展开
+    SubsetMap buildSToJMap(const std::vector<std::vector<int>>& jGroups, int s) {
+        SubsetMap sToJMap;
+        for (const auto& jGroup : jGroups) {
+            forEachCombination(jGroup, s, [&](CombinationView sSubset) {
+                sToJMap[sSubset.toVector()].push_back(jGroup);
+            });
+        }
+        return sToJMap;
+    }
+
+    // s子集 -> 包含它的j组，对每个s子集枚举其在样本中的j元超集，不经过j组列表
+    // 要求样本升序，此时超集按字典序产生，与逐个展开j组得到的顺序一致
+    SubsetMap buildSToJMapBySupersets(const std::vector<int>& samples, int j, int s) {
+        SubsetMap sToJMap;
+        const CombinationMask universe = toMask(samples);
+        forEachCombination(samples, s, [&](CombinationView sSubset) {
+            auto& jGroupsForS = sToJMap[sSubset.toVector()];
+            jGroupsForS.reserve(binomial(static_cast<int>(samples.size()) - s, j - s));
+            forEachSupermaskOfSize(toMask(sSubset.toVector()), universe, j, [&](CombinationMask jGroup) {
+                jGroupsForS.push_back(fromMask(jGroup));
+                return true;
+            });
+        });
+        return sToJMap;
+    }
+} // anonymous namespace
+
 Preprocessor::Preprocessor(
     std::shared_ptr<CombinationGenerator> combGen,
-    std::shared_ptr<SetOperations> setOps
-) : m_combGen(combGen), m_setOps(setOps) {}
+    std::shared_ptr<SetOperations> setOps,
+    const Config& config
+) : m_combGen(combGen), m_setOps(setOps), m_config(config) {}
 
 std::unique_ptr<Preprocessor::SelectionStrategy> Preprocessor::createStrategy(CoverageMode mode) const {
     switch (mode) {
         case CoverageMode::CoverMinOneS:
-            return std::make_unique<ModeAStrategy>();
+            return std::make_unique<ModeAStrategy>(m_config.maxCacheBytes);
         case CoverageMode::CoverMinNS:
             return std::make_unique<ModeBStrategy>();
         case CoverageMode::CoverAllS:
@@ -75,25 +120,37 @@ PreprocessResult Preprocessor::preprocess(
         result.sToJMap = existingSToJMap;
         result.jToSMap = existingJToSMap;
     } else {
-        size_t totalSSubsetsInJ = 0;
-        for (const auto& jGroup : result.jGroups) {
-            auto sSubsetsForJ = m_combGen->generate(jGroup, s);
-            totalSSubsetsInJ += sSubsetsForJ.size();
-            result.jToSMap[jGroup] = sSubsetsForJ;
-            
-            for (const auto& sSubset : sSubsetsForJ) {
-                result.sToJMap[sSubset].push_back(jGroup);
-            }
+        // 映射改为首次访问时构建，选择策略本身只使用稠密下标映射
+        auto jGroups = std::make_shared<const std::vector<std::vector<int>>>(result.jGroups);
+        result.jToSMap.setBuilder([jGroups, s]() {
+            return buildJToSMap(*jGroups, s);
+        });
+        // 样本升序且j组为全部组合时，直接由每个s子集向外扩展出包含它的j组
+        const bool fullJGroups = std::is_sorted(samples.begin(), samples.end()) &&
+            result.jGroups.size() == binomial(static_cast<int>(samples.size()), j);
+        if (fullJGroups) {
+            result.sToJMap.setBuilder([samples, j, s]() {
+                return buildSToJMapBySupersets(samples, j, s);
+            });
+        } else {
+            result.sToJMap.setBuilder([jGroups, s]() {
+                return buildSToJMap(*jGroups, s);
+            });
         }
         std::cout << "j组中s子集的平均数量: " << std::fixed << std::setprecision(2) 
-                  << static_cast<double>(totalSSubsetsInJ) / result.jGroups.size() << std::endl;
+                  << static_cast<double>(binomial(j, s)) << std::endl;
     }
     
+    // 建立按组合数下标索引的稠密映射，供选择策略在热点循环中使用
+    CombinadicRanker ranker(samples);
+    buildRankAdjacency(ranker, j, s, result.jToSRanks, result.sToJRanks);
+    
     // 3. 根据mode选择策略并执行selectTopS
     auto strategy = createStrategy(mode);
     result.selectedSSubsets = strategy->selectTopS(
         result.allSSubsets,
-        result.sToJMap,
+        result.sToJRanks,
+        ranker,
         result.jGroups,
         n,
         k
@@ -128,7 +185,8 @@ size_t calculateTheoreticalTopSCount(int n, int j, int s) {
 // Mode A: 每个j组至少有一个s子集被选中
 std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
     const std::vector<std::vector<int>>& allSSubsets,
-    const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+    const std::vector<std::vector<size_t>>& sToJRanks,
+    const CombinadicRanker& ranker,
     const std::vector<std::vector<int>>& jGroups,
     int n,
     int k
@@ -136,7 +194,55 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
     std::cout << "\n=== ModeA::selectTopS 开始 ===" << std::endl;
     
     std::vector<std::vector<int>> selectedS;
-    std::set<std::vector<int>> coveredJGroups;
+    
+    // 以组合数下标记录j组覆盖状态与s子集选中状态，避免以向量为键的查找
+    std::vector<char> coveredJ(jGroups.size(), 0);
+    size_t coveredJCount = 0;
+    std::vector<char> isSelected(allSSubsets.size(), 0);
+    std::vector<size_t> sRanks;
+    sRanks.reserve(allSSubsets.size());
+    for (const auto& subset : allSSubsets) {
+        sRanks.push_back(ranker.rank(toMask(subset)));
+    }
+    
+    // s子集 × j组关联矩阵：每行的字数不多于一个s子集覆盖的j组数时，
+    // 新增覆盖按位统计比逐个下标检查更快
+    IncidenceMatrix sToJIncidence;
+    const size_t jPerS = sToJRanks.empty() ? 0 : sToJRanks.front().size();
+    if ((jGroups.size() + IncidenceMatrix::WORD_BITS - 1) / IncidenceMatrix::WORD_BITS <= jPerS &&
+        IncidenceMatrix::estimateBytes(sToJRanks.size(), jGroups.size()) <= m_maxIncidenceBytes) {
+        sToJIncidence = IncidenceMatrix::fromAdjacency(sToJRanks, jGroups.size());
+    }
+    std::vector<IncidenceMatrix::Word> coveredWords(sToJIncidence.wordsPerRow(), 0);
+    
+    // 统计一个s子集能新覆盖的j组数
+    auto countNewCoverage = [&](size_t idx) {
+        if (!sToJIncidence.empty()) {
+            return sToJIncidence.countUncovered(sRanks[idx], coveredWords.data());
+        }
+        size_t newCoverage = 0;
+        for (size_t jRank : sToJRanks[sRanks[idx]]) {
+            if (!coveredJ[jRank]) {
+                newCoverage++;
+            }
+        }
+        return newCoverage;
+    };
+    
+    // 选中一个s子集并更新其覆盖的j组
+    auto selectSubset = [&](size_t idx) {
+        selectedS.push_back(allSSubsets[idx]);
+        isSelected[idx] = 1;
+        if (!sToJIncidence.empty()) {
+            sToJIncidence.mergeRow(sRanks[idx], coveredWords.data());
+        }
+        for (size_t jRank : sToJRanks[sRanks[idx]]) {
+            if (!coveredJ[jRank]) {
+                coveredJ[jRank] = 1;
+                coveredJCount++;
+            }
+        }
+    };
     
     // 第一阶段：大步覆盖
     // 设置较高的覆盖阈值，只选择能显著增加覆盖的s子集
@@ -144,26 +250,23 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
     std::cout << "阶段1 - 大步覆盖（覆盖阈值: " << (PHASE1_COVERAGE_THRESHOLD * 100) << "%）" << std::endl;
     
     bool continuePhase1 = true;
-    while (continuePhase1 && coveredJGroups.size() < jGroups.size()) {
+    while (continuePhase1 && coveredJCount < jGroups.size()) {
         size_t maxNewCoverage = 0;
         std::vector<int> bestSubset;
+        size_t bestIdx = 0;
         double bestJaccardMin = 0.0;  // 与已选集合的最小Jaccard距离
         
-        for (const auto& subset : allSSubsets) {
-            if (std::find(selectedS.begin(), selectedS.end(), subset) != selectedS.end()) {
+        for (size_t idx = 0; idx < allSSubsets.size(); ++idx) {
+            const auto& subset = allSSubsets[idx];
+            if (isSelected[idx]) {
                 continue;
             }
             
-            auto it = sToJMap.find(subset);
-            if (it == sToJMap.end()) continue;
+            const auto& coveredBy = sToJRanks[sRanks[idx]];
+            if (coveredBy.empty()) continue;
             
             // 计算新增覆盖
-            size_t newCoverage = 0;
-            for (const auto& jGroup : it->second) {
-                if (coveredJGroups.find(jGroup) == coveredJGroups.end()) {
-                    newCoverage++;
-                }
-            }
+            size_t newCoverage = countNewCoverage(idx);
             
             // 计算覆盖率增量
             double coverageIncrease = static_cast<double>(newCoverage) / jGroups.size();
@@ -190,17 +293,14 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
                     (newCoverage == maxNewCoverage && minJaccard > bestJaccardMin)) {
                     maxNewCoverage = newCoverage;
                     bestSubset = subset;
+                    bestIdx = idx;
                     bestJaccardMin = minJaccard;
                 }
             }
         }
         
         if (maxNewCoverage > 0) {
-            selectedS.push_back(bestSubset);
-            auto it = sToJMap.find(bestSubset);
-            for (const auto& jGroup : it->second) {
-                coveredJGroups.insert(jGroup);
-            }
+            selectSubset(bestIdx);
             
             std::cout << "选择 s: {";
             for (size_t idx = 0; idx < bestSubset.size(); ++idx) {
@@ -208,9 +308,9 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
                 std::cout << bestSubset[idx];
             }
             std::cout << "}, 新增覆盖: " << maxNewCoverage
-                      << ", 当前总覆盖: " << coveredJGroups.size() << "/" << jGroups.size()
+                      << ", 当前总覆盖: " << coveredJCount << "/" << jGroups.size()
                       << " (" << std::fixed << std::setprecision(2)
-                      << (static_cast<double>(coveredJGroups.size()) / jGroups.size() * 100)
+                      << (static_cast<double>(coveredJCount) / jGroups.size() * 100)
                       << "%)" << std::endl;
         } else {
             continuePhase1 = false;
@@ -225,18 +325,20 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
     std::cout << "\n阶段2 - 低重叠精调（覆盖阈值: " << (PHASE2_COVERAGE_THRESHOLD * 100) 
               << "%, Jaccard阈值: " << (PHASE2_JACCARD_THRESHOLD * 100) << "%）" << std::endl;
     
-    while (coveredJGroups.size() < jGroups.size()) {
+    while (coveredJCount < jGroups.size()) {
         size_t maxNewCoverage = 0;
         std::vector<int> bestSubset;
+        size_t bestIdx = 0;
         double bestJaccardMin = 0.0;
         
-        for (const auto& subset : allSSubsets) {
-            if (std::find(selectedS.begin(), selectedS.end(), subset) != selectedS.end()) {
+        for (size_t idx = 0; idx < allSSubsets.size(); ++idx) {
+            const auto& subset = allSSubsets[idx];
+            if (isSelected[idx]) {
                 continue;
             }
             
-            auto it = sToJMap.find(subset);
-            if (it == sToJMap.end()) continue;
+            const auto& coveredBy = sToJRanks[sRanks[idx]];
+            if (coveredBy.empty()) continue;
             
             // 计算与已选集合的最小Jaccard距离
             double minJaccard = 1.0;
@@ -255,12 +357,7 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
             
             // 只考虑与已选集合有足够距离的子集
             if (minJaccard >= PHASE2_JACCARD_THRESHOLD) {
-                size_t newCoverage = 0;
-                for (const auto& jGroup : it->second) {
-                    if (coveredJGroups.find(jGroup) == coveredJGroups.end()) {
-                        newCoverage++;
-                    }
-                }
+                size_t newCoverage = countNewCoverage(idx);
                 
                 double coverageIncrease = static_cast<double>(newCoverage) / jGroups.size();
                 if (coverageIncrease >= PHASE2_COVERAGE_THRESHOLD && 
@@ -268,17 +365,14 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
                      (newCoverage == maxNewCoverage && minJaccard > bestJaccardMin))) {
                     maxNewCoverage = newCoverage;
                     bestSubset = subset;
+                    bestIdx = idx;
                     bestJaccardMin = minJaccard;
                 }
             }
         }
         
         if (maxNewCoverage > 0) {
-            selectedS.push_back(bestSubset);
-            auto it = sToJMap.find(bestSubset);
-            for (const auto& jGroup : it->second) {
-                coveredJGroups.insert(jGroup);
-            }
+            selectSubset(bestIdx);
             
             std::cout << "选择 s: {";
             for (size_t idx = 0; idx < bestSubset.size(); ++idx) {
@@ -288,9 +382,9 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
             std::cout << "}, 新增覆盖: " << maxNewCoverage
                       << ", Jaccard距离: " << std::fixed << std::setprecision(2) 
                       << (bestJaccardMin * 100) << "%"
-                      << ", 当前总覆盖: " << coveredJGroups.size() << "/" << jGroups.size()
+                      << ", 当前总覆盖: " << coveredJCount << "/" << jGroups.size()
                       << " (" << std::fixed << std::setprecision(2)
-                      << (static_cast<double>(coveredJGroups.size()) / jGroups.size() * 100)
+                      << (static_cast<double>(coveredJCount) / jGroups.size() * 100)
                       << "%)" << std::endl;
         } else {
             break;
@@ -306,35 +400,29 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
         hasImprovement = false;
         size_t maxNewCoverage = 0;
         std::vector<int> bestSubset;
+        size_t bestIdx = 0;
         
-        for (const auto& subset : allSSubsets) {
-            if (std::find(selectedS.begin(), selectedS.end(), subset) != selectedS.end()) {
+        for (size_t idx = 0; idx < allSSubsets.size(); ++idx) {
+            const auto& subset = allSSubsets[idx];
+            if (isSelected[idx]) {
                 continue;
             }
             
-            auto it = sToJMap.find(subset);
-            if (it == sToJMap.end()) continue;
+            const auto& coveredBy = sToJRanks[sRanks[idx]];
+            if (coveredBy.empty()) continue;
             
-            size_t newCoverage = 0;
-            for (const auto& jGroup : it->second) {
-                if (coveredJGroups.find(jGroup) == coveredJGroups.end()) {
-                    newCoverage++;
-                }
-            }
+            size_t newCoverage = countNewCoverage(idx);
             
             if (newCoverage > maxNewCoverage) {
                 maxNewCoverage = newCoverage;
                 bestSubset = subset;
+                bestIdx = idx;
             }
         }
         
         if (maxNewCoverage > 0) {
             hasImprovement = true;
-            selectedS.push_back(bestSubset);
-            auto it = sToJMap.find(bestSubset);
-            for (const auto& jGroup : it->second) {
-                coveredJGroups.insert(jGroup);
-            }
+            selectSubset(bestIdx);
             
             std::cout << "选择 s: {";
             for (size_t idx = 0; idx < bestSubset.size(); ++idx) {
@@ -342,17 +430,17 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
                 std::cout << bestSubset[idx];
             }
             std::cout << "}, 新增覆盖: " << maxNewCoverage
-                      << ", 当前总覆盖: " << coveredJGroups.size() << "/" << jGroups.size()
+                      << ", 当前总覆盖: " << coveredJCount << "/" << jGroups.size()
                       << " (" << std::fixed << std::setprecision(2)
-                      << (static_cast<double>(coveredJGroups.size()) / jGroups.size() * 100)
+                      << (static_cast<double>(coveredJCount) / jGroups.size() * 100)
                       << "%)" << std::endl;
         }
-    } while (hasImprovement && coveredJGroups.size() < jGroups.size());
+    } while (hasImprovement && coveredJCount < jGroups.size());
     
     std::cout << "最终选择了 " << selectedS.size() << " 个s子集" << std::endl;
-    std::cout << "最终覆盖了 " << coveredJGroups.size() << "/" << jGroups.size() 
+    std::cout << "最终覆盖了 " << coveredJCount << "/" << jGroups.size() 
               << " 个j组 (" << std::fixed << std::setprecision(2)
-              << (static_cast<double>(coveredJGroups.size()) / jGroups.size() * 100)
+              << (static_cast<double>(coveredJCount) / jGroups.size() * 100)
               << "%)" << std::endl;
     std::cout << "=== ModeA::selectTopS 结束 ===\n" << std::endl;
     
@@ -362,7 +450,8 @@ std::vector<std::vector<int>> Preprocessor::ModeAStrategy::selectTopS(
 // Mode B: 每个j组至少有N个不同的s子集被选中
 std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
     const std::vector<std::vector<int>>& allSSubsets,
-    const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+    const std::vector<std::vector<size_t>>& sToJRanks,
+    const CombinadicRanker& ranker,
     const std::vector<std::vector<int>>& jGroups,
     int n,
     int k
@@ -372,11 +461,8 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
     
     std::vector<std::vector<int>> selectedS;
     
-    // 维护每个j组的覆盖次数
-    std::map<std::vector<int>, int> jCoverageCount;
-    for (const auto& j : jGroups) {
-        jCoverageCount[j] = 0;
-    }
+    // 维护每个j组的覆盖次数（以组合数下标索引）
+    std::vector<int> jCoverageCount(jGroups.size(), 0);
     
     // 计算每个s子集的得分
     struct SubsetScore {
@@ -392,11 +478,8 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
         
         // 1. 计算覆盖得分：根据公式 score(s) = ∑max(0, 2-coverage[j])
         double coverage_score = 0.0;
-        auto it = sToJMap.find(s);
-        if (it != sToJMap.end()) {
-            for (const auto& j : it->second) {
-                coverage_score += std::max(0.0, 2.0 - jCoverageCount[j]);
-            }
+        for (size_t jRank : sToJRanks[ranker.rank(toMask(s))]) {
+            coverage_score += std::max(0.0, 2.0 - jCoverageCount[jRank]);
         }
         
         // 2. 计算多样性得分：与已选s的Jaccard距离
@@ -450,11 +533,8 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
         selectedS.push_back(best_candidate->subset);
         
         // 更新覆盖计数
-        auto it = sToJMap.find(best_candidate->subset);
-        if (it != sToJMap.end()) {
-            for (const auto& j : it->second) {
-                jCoverageCount[j]++;
-            }
+        for (size_t jRank : sToJRanks[ranker.rank(toMask(best_candidate->subset))]) {
+            jCoverageCount[jRank]++;
         }
         
         // 输出选择信息
@@ -469,7 +549,7 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
         
         // 检查是否所有j组都被覆盖至少2次
         all_covered_twice = true;
-        for (const auto& [j, count] : jCoverageCount) {
+        for (int count : jCoverageCount) {
             if (count < 2) {
                 all_covered_twice = false;
                 break;
@@ -482,7 +562,7 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
     // 输出覆盖统计
     std::cout << "\n覆盖统计:" << std::endl;
     std::map<int, int> coverage_distribution;
-    for (const auto& [_, count] : jCoverageCount) {
+    for (int count : jCoverageCount) {
         coverage_distribution[count]++;
     }
     for (const auto& [count, frequency] : coverage_distribution) {
@@ -498,7 +578,8 @@ std::vector<std::vector<int>> Preprocessor::ModeBStrategy::selectTopS(
 // Mode C: 每个j组的所有s子集都被选中
 std::vector<std::vector<int>> Preprocessor::ModeCStrategy::selectTopS(
     const std::vector<std::vector<int>>& allSSubsets,
-    const std::map<std::vector<int>, std::vector<std::vector<int>>>& sToJMap,
+    const std::vector<std::vector<size_t>>& sToJRanks,
+    const CombinadicRanker& ranker,
     const std::vector<std::vector<int>>& jGroups,
     int n,
     int k
@@ -1,10 +1,10 @@
 #include "set_operations.hpp"
 #include "timer.hpp"
+#include "thread_pool.hpp"
 #include <algorithm>
 #include <unordered_set>
+#include <unordered_map>
 #include <numeric>
-#include <future>
-#include <thread>
 #include <iostream>
 
 namespace core_algo {
@@ -13,7 +13,8 @@ namespace {
     class SetOperationsImpl : public SetOperations {
     private:
         Config config;
-        const size_t NUM_THREADS = std::thread::hardware_concurrency();
+        std::shared_ptr<ThreadPool> pool;
+        const size_t NUM_THREADS;
         static constexpr size_t LARGE_SET_THRESHOLD = 5000;
         
         // 缓存常用的集合操作结果
@@ -31,36 +32,34 @@ namespace {
             return hash;
         }
 
-        // 并发处理大型集合
+        // 并发处理大型集合：按线程池大小分批，每批在池中独立求并集/交集后合并
         std::vector<int> parallelSetOperation(
             const std::vector<std::vector<int>>& sets,
             bool isUnion
         ) const {
             const size_t batchSize = (sets.size() + NUM_THREADS - 1) / NUM_THREADS;
-            std::vector<std::future<std::unordered_set<int>>> futures;
-
-            for (size_t i = 0; i < sets.size(); i += batchSize) {
-                size_t end = std::min(i + batchSize, sets.size());
-                futures.push_back(std::async(std::launch::async,
-                    [this, &sets, i, end]() {
-                        return this->processSetsBatch(sets, i, end);
-                    }));
-            }
+            const size_t batchCount = (sets.size() + batchSize - 1) / batchSize;
+            std::vector<std::unordered_set<int>> partials(batchCount);
+
+            pool->parallelFor(0, batchCount, [&](size_t begin, size_t end) {
+                for (size_t b = begin; b < end; ++b) {
+                    partials[b] = processSetsBatch(sets, b * batchSize,
+                                                   std::min((b + 1) * batchSize, sets.size()), isUnion);
+                }
+            }, 1);
 
             std::unordered_set<int> result;
             if (isUnion) {
-                for (auto& future : futures) {
-                    auto partialResult = future.get();
+                for (const auto& partialResult : partials) {
                     result.insert(partialResult.begin(), partialResult.end());
                 }
             } else {  // intersection
-                if (!futures.empty()) {
-                    result = futures[0].get();
-                    for (size_t i = 1; i < futures.size(); ++i) {
-                        auto partialResult = futures[i].get();
+                if (!partials.empty()) {
+                    result = std::move(partials[0]);
+                    for (size_t i = 1; i < partials.size(); ++i) {
                         std::unordered_set<int> tempSet;
                         for (const auto& elem : result) {
-                            if (partialResult.find(elem) != partialResult.end()) {
+                            if (partials[i].find(elem) != partials[i].end()) {
                                 tempSet.insert(elem);
                             }
                         }
@@ -77,8 +76,20 @@ namespace {
         std::unordered_set<int> processSetsBatch(
             const std::vector<std::vector<int>>& sets,
             size_t startIdx,
-            size_t endIdx
+            size_t endIdx,
+            bool isUnion
         ) const {
+            if (!isUnion) {
+                // 批内交集，批间再求交集
+                std::unordered_set<int> result(sets[startIdx].begin(), sets[startIdx].end());
+                for (size_t i = startIdx + 1; i < endIdx && !result.empty(); ++i) {
+                    std::unordered_set<int> current(sets[i].begin(), sets[i].end());
+                    for (auto it = result.begin(); it != result.end();) {
+                        it = current.count(*it) ? std::next(it) : result.erase(it);
+                    }
+                }
+                return result;
+            }
             std::unordered_set<int> result;
             result.reserve(LARGE_SET_THRESHOLD);  // 预分配空间
             for (size_t i = startIdx; i < endIdx; ++i) {
@@ -88,8 +99,10 @@ namespace {
         }
 
     public:
+        using SetOperations::contains;
+
         explicit SetOperationsImpl(const Config& config = Config()) 
-            : config(config) {}
+            : config(config), pool(ThreadPool::forConfig(config)), NUM_THREADS(pool->threadCount()) {}
 
         std::vector<int> getUnion(const std::vector<std::vector<int>>& sets) const override {
             Timer timer("计算并集");
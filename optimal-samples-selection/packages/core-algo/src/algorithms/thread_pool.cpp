@@ -0,0 +1,209 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core_algo {
+
+namespace {
+    using Chunk = std::pair<size_t, size_t>;
+
+    // 一次 parallelFor 调用的共享状态，由调用线程与参与的工作线程共同持有
+    struct Job {
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Chunk> chunks;
+        };
+
+        explicit Job(size_t slots) : queues(slots) {}
+
+        std::vector<Queue> queues;  // 每个参与线程一个本地队列
+        ThreadPool::RangeBody body;
+        std::atomic<size_t> remaining{0};
+
+        std::mutex doneMutex;
+        std::condition_variable done;
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        // 从本地队列头部取块
+        bool popLocal(size_t slot, Chunk& chunk) {
+            auto& queue = queues[slot];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.chunks.empty()) return false;
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            return true;
+        }
+
+        // 从其他线程的队列尾部窃取
+        bool steal(size_t slot, Chunk& chunk) {
+            for (size_t offset = 1; offset < queues.size(); ++offset) {
+                auto& queue = queues[(slot + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.chunks.empty()) {
+                    chunk = queue.chunks.back();
+                    queue.chunks.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void participate(size_t slot) {
+            Chunk chunk;
+            while (popLocal(slot, chunk) || steal(slot, chunk)) {
+                try {
+                    body(chunk.first, chunk.second);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+                if (--remaining == 0) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done.notify_all();
+                }
+            }
+        }
+    };
+
+    class ThreadPoolImpl : public ThreadPool {
+    private:
+        const size_t m_threadCount;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<std::function<void()>> m_tasks;
+        bool m_stop = false;
+
+        void workerLoop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                    if (m_stop && m_tasks.empty()) return;
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    public:
+        explicit ThreadPoolImpl(size_t threadCount)
+            : m_threadCount(std::max<size_t>(1, threadCount)) {
+            // 调用线程参与计算，只需额外启动 threadCount - 1 个工作线程
+            m_workers.reserve(m_threadCount - 1);
+            for (size_t i = 1; i < m_threadCount; ++i) {
+                m_workers.emplace_back(&ThreadPoolImpl::workerLoop, this);
+            }
+        }
+
+        ~ThreadPoolImpl() override {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        size_t threadCount() const override {
+            return m_threadCount;
+        }
+
+        void parallelFor(size_t begin, size_t end, const RangeBody& body, size_t grainSize) override {
+            if (end <= begin) return;
+            const size_t count = end - begin;
+            const size_t grain = grainSize > 0 ? grainSize : chunkSize(count, m_threadCount);
+            if (m_threadCount == 1 || count <= grain) {
+                body(begin, end);
+                return;
+            }
+
+            const size_t chunkCount = (count + grain - 1) / grain;
+            const size_t slots = std::min(m_threadCount, chunkCount);
+            auto job = std::make_shared<Job>(slots);
+            job->body = body;
+            job->remaining = chunkCount;
+
+            // 连续的块分给同一线程，保持访问局部性
+            for (size_t c = 0; c < chunkCount; ++c) {
+                const size_t start = begin + c * grain;
+                job->queues[c * slots / chunkCount].chunks.emplace_back(start, std::min(start + grain, end));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (size_t slot = 1; slot < slots; ++slot) {
+                    m_tasks.emplace_back([job, slot]() { job->participate(slot); });
+                }
+            }
+            m_wake.notify_all();
+
+            job->participate(0);
+            {
+                std::unique_lock<std::mutex> lock(job->doneMutex);
+                job->done.wait(lock, [&job]() { return job->remaining == 0; });
+            }
+
+            if (job->error) {
+                std::rethrow_exception(job->error);
+            }
+        }
+    };
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // 未启用 pthreads 的 WebAssembly 构建无法创建线程
+    constexpr bool THREADS_SUPPORTED = false;
+#else
+    constexpr bool THREADS_SUPPORTED = true;
+#endif
+
+    size_t hardwareThreads() {
+        return THREADS_SUPPORTED ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    }
+} // anonymous namespace
+
+size_t ThreadPool::chunkSize(size_t count, size_t threads, size_t minGrain) {
+    const size_t chunks = std::max<size_t>(1, threads) * CHUNKS_PER_THREAD;
+    return std::max(std::max<size_t>(1, minGrain), (count + chunks - 1) / chunks);
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount) {
+    return std::make_shared<ThreadPoolImpl>(THREADS_SUPPORTED ? threadCount : 1);
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::shared(size_t threadCount) {
+    static std::mutex registryMutex;
+    // 共享线程池在进程生命周期内保留，工作线程只创建一次
+    static std::map<size_t, std::shared_ptr<ThreadPool>> registry;
+
+    threadCount = std::max<size_t>(1, threadCount);
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto& pool = registry[threadCount];
+    if (!pool) {
+        pool = create(threadCount);
+    }
+    return pool;
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::forConfig(const Config& config) {
+    if (!config.enableParallel) {
+        return shared(1);
+    }
+    return shared(config.threadCount > 0 ? static_cast<size_t>(config.threadCount) : hardwareThreads());
+}
+
+} // namespace core_algo
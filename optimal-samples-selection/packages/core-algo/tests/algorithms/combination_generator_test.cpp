@@ -1,12 +1,15 @@
 #include <gtest/gtest.h>
 #include "combination_generator.hpp"
+#include "combination_visitor.hpp"
 #include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <numeric>
 #include <random>
 #include <set>
+#include <map>
 #include <algorithm>
+#include <thread>
 
 using namespace core_algo;
 using namespace std::chrono;
@@ -505,4 +508,251 @@ TEST_F(CombinationGeneratorTest, MinimalValidParameters) {
         // 验证生成的子集
         EXPECT_EQ(s_subsets[0], j_combination) << "j=s时应该只有一个子集，且等于j组合本身";
     }
-} 
\ No newline at end of file
+} 
+// 测试位掩码形式的组合生成
+TEST_F(CombinationGeneratorTest, GenerateMasks) {
+    std::vector<int> samples = {2, 5, 7, 11, 13, 54};
+    int r = 3;
+
+    auto combinations = generator->generate(samples, r);
+    auto masks = generator->generateMasks(samples, r);
+
+    // 掩码与向量形式一一对应，顺序一致
+    ASSERT_EQ(masks.size(), combinations.size());
+    for (size_t i = 0; i < masks.size(); ++i) {
+        EXPECT_EQ(maskPopcount(masks[i]), r) << "掩码元素个数不正确";
+        EXPECT_EQ(masks[i], toMask(combinations[i])) << "掩码与组合不一致";
+        EXPECT_EQ(fromMask(masks[i]), combinations[i]) << "掩码还原结果不正确";
+    }
+
+    // 超出位掩码范围的样本值应抛出异常
+    EXPECT_THROW(generator->generateMasks({1, 2, 64}, 2), AlgorithmError);
+}
+
+TEST_F(CombinationGeneratorTest, RankUnrank) {
+    std::vector<int> samples = {2, 5, 7, 11, 13, 54, 60};
+    int r = 4;
+    size_t n = samples.size();
+
+    auto indexCombinations = generator->generate({0, 1, 2, 3, 4, 5, 6}, r);
+    auto masks = generator->generateMasks(samples, r);
+
+    // 下标与 generate() 的字典序一致，且 rank/unrank 互为逆运算
+    ASSERT_EQ(indexCombinations.size(), generator->getCombinationCount(n, r));
+    for (size_t i = 0; i < indexCombinations.size(); ++i) {
+        EXPECT_EQ(generator->rank(indexCombinations[i], n), i) << "组合下标不正确";
+        EXPECT_EQ(generator->unrank(i, n, r), indexCombinations[i]) << "下标还原结果不正确";
+        EXPECT_EQ(generator->rankMask(masks[i], samples), i) << "掩码下标不正确";
+        EXPECT_EQ(generator->unrankMask(i, samples, r), masks[i]) << "掩码还原结果不正确";
+    }
+
+    // 非法输入应抛出异常
+    EXPECT_THROW(generator->rank({3, 1}, n), AlgorithmError);
+    EXPECT_THROW(generator->rank({0, 7}, n), AlgorithmError);
+    EXPECT_THROW(generator->unrank(indexCombinations.size(), n, r), AlgorithmError);
+    EXPECT_THROW(generator->rankMask(toMask({2, 3}), samples), AlgorithmError);
+}
+
+TEST_F(CombinationGeneratorTest, GenerateFlat) {
+    std::vector<int> samples = {3, 8, 15, 16, 23, 42};
+    int j = 4;
+    int s = 2;
+
+    // 扁平存储与嵌套向量逐行一致
+    auto nested = generator->generate(samples, j);
+    auto flat = generator->generateFlat(samples, j);
+    ASSERT_EQ(flat.stride, j);
+    ASSERT_EQ(flat.size(), nested.size());
+    EXPECT_EQ(flat.data.size(), nested.size() * j);
+    EXPECT_EQ(flat.toNested(), nested);
+
+    // CSR 分组：第 g 组为第 g 个j组合的全部s子集
+    auto sFlat = generator->generateFlatSSubsets(flat, s);
+    ASSERT_EQ(sFlat.groupCount(), nested.size());
+    for (size_t g = 0; g < nested.size(); ++g) {
+        auto expected = generator->generateSSubsetsForJCombination(nested[g], s);
+        ASSERT_EQ(sFlat.groupEnd(g) - sFlat.groupBegin(g), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(sFlat.at(sFlat.groupBegin(g) + i), expected[i]);
+        }
+    }
+
+    EXPECT_TRUE(generator->generateFlat(samples, 7).empty());
+    EXPECT_THROW(generator->generateFlatSSubsets(flat, 5), AlgorithmError);
+}
+
+TEST_F(CombinationGeneratorTest, GenerateParallelMatchesSerial) {
+    Config parallelConfig;
+    parallelConfig.enableParallel = true;
+    auto parallelGenerator = CombinationGenerator::create(parallelConfig);
+
+    std::vector<int> elements(20);
+    std::iota(elements.begin(), elements.end(), 1);
+
+    // 各线程从反排序得到的起点开始生成，拼接结果应与串行生成完全一致
+    for (int threads : {2, 3, 8}) {
+        auto parallel = parallelGenerator->generateParallel(elements, 5, threads);
+        auto serial = generator->generate(elements, 5);
+        ASSERT_EQ(parallel.size(), serial.size());
+        EXPECT_EQ(parallel, serial) << "线程数 " << threads << " 时结果不一致";
+    }
+}
+
+TEST_F(CombinationGeneratorTest, ForEachCombination) {
+    std::vector<int> samples = {4, 9, 10, 17, 33, 50, 63};
+    int r = 3;
+
+    // 访问顺序与 generate() 一致
+    auto expected = generator->generate(samples, r);
+    std::vector<std::vector<int>> visited;
+    bool completed = forEachCombination(samples, r, [&](CombinationView combination) {
+        visited.push_back(combination.toVector());
+    });
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(visited, expected);
+
+    // 掩码版本与 generateMasks() 一致
+    std::vector<CombinationMask> masks;
+    forEachCombinationMask(samples, r, [&](CombinationMask mask) {
+        masks.push_back(mask);
+        return true;
+    });
+    EXPECT_EQ(masks, generator->generateMasks(samples, r));
+
+    // 回调返回 false 时提前停止
+    size_t count = 0;
+    completed = forEachCombination(samples, r, [&](CombinationView) {
+        return ++count < 5;
+    });
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(count, 5u);
+
+    // r 超出范围时不访问任何组合
+    EXPECT_TRUE(forEachCombination(samples, 8, [&](CombinationView) { ADD_FAILURE(); }));
+}
+
+TEST_F(CombinationGeneratorTest, ForEachSupermask) {
+    std::vector<int> samples = {2, 3, 5, 8, 13, 21, 34};
+    std::vector<int> sSubset = {3, 13};
+    int j = 4;
+
+    // 包含s子集的j组，按字典序与逐个筛选 generate() 结果一致
+    std::vector<std::vector<int>> expected;
+    for (const auto& jGroup : generator->generate(samples, j)) {
+        if (std::includes(jGroup.begin(), jGroup.end(), sSubset.begin(), sSubset.end())) {
+            expected.push_back(jGroup);
+        }
+    }
+    std::vector<std::vector<int>> visited;
+    bool completed = forEachSupermaskOfSize(toMask(sSubset), toMask(samples), j, [&](CombinationMask mask) {
+        visited.push_back(fromMask(mask));
+        return true;
+    });
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(visited.size(), 10u);  // C(5, 2)
+
+    // 提前停止；base 不在 universe 中时不访问
+    size_t count = 0;
+    EXPECT_FALSE(forEachSupermaskOfSize(toMask(sSubset), toMask(samples), j, [&](CombinationMask) {
+        return ++count < 3;
+    }));
+    EXPECT_EQ(count, 3u);
+    EXPECT_TRUE(forEachSupermaskOfSize(toMask({1, 3}), toMask(samples), j, [&](CombinationMask) {
+        ADD_FAILURE();
+        return true;
+    }));
+}
+
+TEST_F(CombinationGeneratorTest, GenerateRevolvingDoor) {
+    std::vector<int> samples = {1, 4, 6, 9, 12, 15, 20, 22};
+    int r = 4;
+
+    std::vector<CombinationSwap> swaps;
+    auto combinations = generator->generateRevolvingDoor(samples, r, &swaps);
+
+    // 与字典序生成的组合集合相同
+    auto expected = generator->generate(samples, r);
+    ASSERT_EQ(combinations.size(), expected.size());
+    EXPECT_EQ(std::set<std::vector<int>>(combinations.begin(), combinations.end()),
+              std::set<std::vector<int>>(expected.begin(), expected.end()));
+
+    // 相邻组合恰好交换一个元素，且与返回的交换记录一致
+    ASSERT_EQ(swaps.size(), combinations.size() - 1);
+    for (size_t i = 1; i < combinations.size(); ++i) {
+        auto next = combinations[i - 1];
+        auto removed = std::find(next.begin(), next.end(), swaps[i - 1].removed);
+        ASSERT_NE(removed, next.end()) << "换出元素不在上一个组合中";
+        EXPECT_EQ(std::count(next.begin(), next.end(), swaps[i - 1].added), 0) << "换入元素已在上一个组合中";
+        *removed = swaps[i - 1].added;
+        std::sort(next.begin(), next.end());
+        EXPECT_EQ(next, combinations[i]) << "第 " << i << " 个组合与交换记录不一致";
+    }
+}
+
+TEST_F(CombinationGeneratorTest, SampleUniform) {
+    std::mt19937 rng(42);
+
+    // 结果为升序、互不相同且位于 [0, n) 内
+    for (size_t n : {5u, 30u, 64u, 100u}) {
+        for (size_t r : {size_t(0), size_t(1), size_t(4), n}) {
+            auto sample = generator->sampleUniform(n, r, rng);
+            ASSERT_EQ(sample.size(), r);
+            for (size_t i = 0; i < r; ++i) {
+                EXPECT_GE(sample[i], 0);
+                EXPECT_LT(sample[i], static_cast<int>(n));
+                if (i > 0) EXPECT_LT(sample[i - 1], sample[i]);
+            }
+        }
+    }
+    EXPECT_THROW(generator->sampleUniform(3, 4, rng), AlgorithmError);
+
+    // 每个组合的出现频率应接近均匀分布：C(6,2) = 15，期望 2000 次
+    std::map<std::vector<int>, int> frequency;
+    for (int i = 0; i < 30000; ++i) {
+        frequency[generator->sampleUniform(6, 2, rng)]++;
+    }
+    ASSERT_EQ(frequency.size(), 15u);
+    for (const auto& [combination, count] : frequency) {
+        EXPECT_NEAR(count, 2000, 300);
+    }
+}
+
+TEST_F(CombinationGeneratorTest, SampleManyUsesSeed) {
+    Config seeded;
+    seeded.randomSeed = 12345;
+    auto first = CombinationGenerator::create(seeded);
+    auto second = CombinationGenerator::create(seeded);
+
+    std::vector<int> samples = {3, 7, 11, 19, 23, 29, 31, 37};
+    auto a = first->sampleMany(samples, 4, 50);
+    auto b = second->sampleMany(samples, 4, 50);
+
+    // 同一线程、同一种子得到相同的序列
+    ASSERT_EQ(a.size(), 50u);
+    EXPECT_EQ(a, b);
+    for (const auto& combination : a) {
+        ASSERT_EQ(combination.size(), 4u);
+        EXPECT_TRUE(std::is_sorted(combination.begin(), combination.end()));
+        for (int value : combination) {
+            EXPECT_NE(std::find(samples.begin(), samples.end(), value), samples.end());
+        }
+    }
+}
+
+TEST_F(CombinationGeneratorTest, SampleManyStreamIndependentOfThread) {
+    Config seeded;
+    seeded.randomSeed = 12345;
+    std::vector<int> samples = {3, 7, 11, 19, 23, 29, 31, 37};
+
+    // 在另一个线程中按流编号抽样，结果与在当前线程中抽样相同
+    auto expected = CombinationGenerator::create(seeded)->sampleMany(samples, 4, 50, 3);
+    std::vector<std::vector<int>> actual;
+    auto generator = CombinationGenerator::create(seeded);
+    std::thread worker([&]() { actual = generator->sampleMany(samples, 4, 50, 3); });
+    worker.join();
+    EXPECT_EQ(actual, expected);
+
+    // 不同的流给出不同的序列
+    EXPECT_NE(CombinationGenerator::create(seeded)->sampleMany(samples, 4, 50, 0), expected);
+}
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <chrono>
 #include <random>
+#include <numeric>
 
 using namespace core_algo;
 
@@ -49,7 +50,7 @@ protected:
             std::cout << "  {";
             for (int elem : j_combinations[i]) std::cout << elem << " ";
             std::cout << "} - " << (result.j_coverage_status[i] ? "已覆盖" : "未覆盖");
-            std::cout << " (覆盖的S子集数: " << result.j_covered_s_counts[i] << ")" << std::endl;
+            std::cout << " (覆盖的S子集数: " << static_cast<int>(result.j_covered_s_counts[i]) << ")" << std::endl;
             
             std::cout << "  S子集:" << std::endl;
             for (const auto& subset : s_subsets[i]) {
@@ -430,6 +431,253 @@ TEST_F(CoverageCalculatorSmallTest, LargeScalePerformanceTest) {
     }
 }
 
+// 测试用例：位掩码版本与向量版本结果一致
+TEST_F(CoverageCalculatorSmallTest, MaskOverloadMatchesVectorVersion) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8};
+    const int j = 5;
+    const int s = 3;
+    std::vector<std::vector<int>> k_groups = {{1, 2, 3, 4, 5, 6}, {3, 4, 6, 7, 8, 1}};
+
+    auto j_combinations = combGen->generate(samples, j);
+    std::vector<std::vector<std::vector<int>>> s_subsets;
+    for (const auto& j_group : j_combinations) {
+        s_subsets.push_back(combGen->generateSSubsetsForJCombination(j_group, s));
+    }
+
+    auto k_masks = toMasks(k_groups);
+    auto j_masks = combGen->generateMasks(samples, j);
+
+    for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+        auto expected = coverageCalc->calculateCoverage(k_groups, j_combinations, s_subsets, mode, 4);
+        auto actual = coverageCalc->calculateCoverage(k_masks, j_masks, s, mode, 4);
+
+        EXPECT_EQ(actual.covered_j_count, expected.covered_j_count);
+        EXPECT_EQ(actual.total_j_count, expected.total_j_count);
+        EXPECT_DOUBLE_EQ(actual.coverage_ratio, expected.coverage_ratio);
+        EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+        EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+    }
+}
+
+TEST_F(CoverageCalculatorSmallTest, FlatOverloadMatchesVectorVersion) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8};
+    const int j = 5;
+    const int s = 3;
+    std::vector<std::vector<int>> k_groups = {{1, 2, 3, 4, 5, 6}, {3, 4, 6, 7, 8, 1}};
+
+    auto j_combinations = combGen->generate(samples, j);
+    std::vector<std::vector<std::vector<int>>> s_subsets;
+    for (const auto& j_group : j_combinations) {
+        s_subsets.push_back(combGen->generateSSubsetsForJCombination(j_group, s));
+    }
+
+    auto k_flat = FlatCombinations::fromNested(k_groups);
+    auto j_flat = combGen->generateFlat(samples, j);
+
+    for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+        auto expected = coverageCalc->calculateCoverage(k_groups, j_combinations, s_subsets, mode, 4);
+        auto actual = coverageCalc->calculateCoverage(k_flat, j_flat, s, mode, 4);
+
+        EXPECT_EQ(actual.covered_j_count, expected.covered_j_count);
+        EXPECT_DOUBLE_EQ(actual.coverage_ratio, expected.coverage_ratio);
+        EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+        EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+    }
+}
+
+// 测试用例：Mode A 的交集popcount判定与逐个s子集检查结果一致
+TEST_F(CoverageCalculatorSmallTest, ModeAClosedFormMatchesSubsetVersion) {
+    std::vector<int> samples = {2, 3, 5, 7, 11, 13, 17, 19, 23};
+    const int j = 5;
+    const int s = 3;
+    std::vector<std::vector<int>> k_groups = {{2, 3, 5, 7, 11, 13}, {7, 13, 17, 19, 23, 2}, {3, 11, 19, 23, 5, 17}};
+
+    auto j_combinations = combGen->generate(samples, j);
+    std::vector<std::vector<std::vector<int>>> s_subsets;
+    for (const auto& j_group : j_combinations) {
+        s_subsets.push_back(combGen->generateSSubsetsForJCombination(j_group, s));
+    }
+
+    for (size_t count = 1; count <= k_groups.size(); ++count) {
+        std::vector<std::vector<int>> selected(k_groups.begin(), k_groups.begin() + count);
+        auto expected = coverageCalc->calculateCoverage(selected, j_combinations, s_subsets, CoverageMode::CoverMinOneS, 1);
+        auto actual = coverageCalc->calculateModeACoverage(selected, samples, j, s);
+
+        EXPECT_EQ(actual.covered_j_count, expected.covered_j_count);
+        EXPECT_EQ(actual.total_j_count, expected.total_j_count);
+        EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+        EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+        EXPECT_EQ(actual.total_groups, static_cast<int>(count));
+    }
+
+    // 没有k组时不覆盖任何j组
+    auto empty = coverageCalc->calculateModeACoverage({}, samples, j, s);
+    EXPECT_EQ(empty.covered_j_count, 0);
+    EXPECT_EQ(empty.total_j_count, 126);
+}
+
+// 测试用例：批量评估的增量与逐个候选重新计算的差值一致
+TEST_F(CoverageCalculatorSmallTest, EvaluateBatchMatchesRecalculation) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const int s = 3;
+    auto candidates = combGen->generateMasks(samples, 6);
+    std::vector<CombinationMask> base = {candidates[0], candidates[100], candidates[150]};
+
+    auto sum = [](const std::vector<uint8_t>& values) {
+        return std::accumulate(values.begin(), values.end(), 0);
+    };
+
+    // j = 5 使用特化内核，j = 9 时 C(9, 3) 超出参数网格，回退到逐个枚举s子集
+    for (int j : {5, 9}) {
+        auto j_masks = combGen->generateMasks(samples, j);
+        for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+            auto deltas = coverageCalc->evaluateBatch(base, candidates, j_masks, s, mode, 5);
+            ASSERT_EQ(deltas.size(), candidates.size());
+
+            auto before = coverageCalc->calculateCoverage(base, j_masks, s, mode, 5);
+            for (size_t c = 0; c < candidates.size(); c += 7) {
+                auto solution = base;
+                solution.push_back(candidates[c]);
+                auto after = coverageCalc->calculateCoverage(solution, j_masks, s, mode, 5);
+                EXPECT_EQ(deltas[c].covered_j_delta, after.covered_j_count - before.covered_j_count)
+                    << "j=" << j << " candidate " << c;
+                EXPECT_EQ(deltas[c].covered_s_delta, sum(after.j_covered_s_counts) - sum(before.j_covered_s_counts))
+                    << "j=" << j << " candidate " << c;
+            }
+        }
+    }
+
+    EXPECT_TRUE(coverageCalc->evaluateBatch(base, {}, combGen->generateMasks(samples, 5), s, CoverageMode::CoverAllS).empty());
+}
+
+// 测试用例：流式版本与位掩码版本结果一致（含乱序样本与超出参数网格的 j）
+TEST_F(CoverageCalculatorSmallTest, StreamingOverloadMatchesMaskVersion) {
+    std::vector<int> samples = {9, 2, 14, 5, 11, 3, 7, 12, 1, 8, 10};
+    std::vector<std::vector<int>> k_groups = {
+        {2, 3, 5, 7, 9, 11}, {1, 8, 10, 12, 14, 2}, {3, 5, 8, 9, 12, 14}, {1, 7, 10, 11, 5, 3}
+    };
+
+    for (int j : {4, 5, 8}) {
+        auto j_masks = combGen->generateMasks(samples, j);
+        for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+            auto expected = coverageCalc->calculateCoverage(toMasks(k_groups), j_masks, 3, mode, 3);
+            auto actual = coverageCalc->calculateCoverage(k_groups, samples, j, 3, mode, 3);
+
+            EXPECT_EQ(actual.covered_j_count, expected.covered_j_count) << "j=" << j;
+            EXPECT_EQ(actual.total_j_count, expected.total_j_count);
+            EXPECT_EQ(actual.total_groups, expected.total_groups);
+            EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+            EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+        }
+    }
+
+    // 多线程时各块从起始下标还原j组合，结果与串行一致
+    Config parallel_config;
+    parallel_config.enableParallel = true;
+    parallel_config.threadCount = 3;
+    auto parallel_calc = CoverageCalculator::create(parallel_config);
+    for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+        auto expected = coverageCalc->calculateCoverage(k_groups, samples, 6, 3, mode, 3);
+        auto actual = parallel_calc->calculateCoverage(k_groups, samples, 6, 3, mode, 3);
+        EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+        EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+    }
+
+    // j 大于样本数时没有j组合
+    auto empty = coverageCalc->calculateCoverage(k_groups, samples, 12, 3, CoverageMode::CoverAllS, 1);
+    EXPECT_EQ(empty.total_j_count, 0);
+}
+
+// 测试用例：提前退出的可行性检查与完整覆盖计算一致
+TEST_F(CoverageCalculatorSmallTest, FirstUncoveredMatchesFullCoverage) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    auto candidates = combGen->generateMasks(samples, 6);
+    auto j_masks = combGen->generateMasks(samples, 5);
+
+    Config parallel_config;
+    parallel_config.enableParallel = true;
+    parallel_config.threadCount = 3;
+    auto parallel_calc = CoverageCalculator::create(parallel_config);
+
+    std::mt19937 rng(17);
+    std::vector<CombinationMask> k_groups;
+    for (size_t count : {0u, 5u, 40u, 200u, 600u}) {
+        while (k_groups.size() < count) {
+            k_groups.push_back(candidates[rng() % candidates.size()]);
+        }
+        for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+            auto full = coverageCalc->calculateCoverage(k_groups, j_masks, 3, mode, 4);
+            const size_t first = full.j_coverage_status.findFirstUnset();
+            const int expected = first == full.j_coverage_status.size() ? -1 : static_cast<int>(first);
+
+            EXPECT_EQ(coverageCalc->firstUncovered(k_groups, j_masks, 3, mode, 4), expected) << "k组数 " << count;
+            EXPECT_EQ(parallel_calc->firstUncovered(k_groups, j_masks, 3, mode, 4), expected) << "k组数 " << count;
+            EXPECT_EQ(coverageCalc->isFeasible(k_groups, j_masks, 3, mode, 4), expected < 0);
+        }
+    }
+
+    // 全部样本组成的k组覆盖所有j组合
+    std::vector<CombinationMask> all = {toMask(samples)};
+    EXPECT_TRUE(coverageCalc->isFeasible(all, j_masks, 3, CoverageMode::CoverAllS));
+    EXPECT_EQ(coverageCalc->firstUncovered(all, j_masks, 3, CoverageMode::CoverAllS), -1);
+    EXPECT_FALSE(coverageCalc->isFeasible({}, j_masks, 3, CoverageMode::CoverMinOneS));
+}
+
+// 测试用例：不同详细程度的结果覆盖率一致，UncoveredList 与 Full 中未覆盖的位一致
+TEST_F(CoverageCalculatorSmallTest, DetailLevelsAgreeWithFullResult) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    auto candidates = combGen->generateMasks(samples, 6);
+    auto j_masks = combGen->generateMasks(samples, 5);
+
+    Config parallel_config;
+    parallel_config.enableParallel = true;
+    parallel_config.threadCount = 3;
+    auto parallel_calc = CoverageCalculator::create(parallel_config);
+
+    std::mt19937 rng(23);
+    std::vector<CombinationMask> k_groups;
+    for (size_t count : {3u, 30u, 120u}) {
+        while (k_groups.size() < count) {
+            k_groups.push_back(candidates[rng() % candidates.size()]);
+        }
+        std::vector<std::vector<int>> k_lists;
+        for (CombinationMask mask : k_groups) {
+            k_lists.push_back(fromMask(mask));
+        }
+        for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+            auto full = coverageCalc->calculateCoverage(k_groups, j_masks, 3, mode, 4);
+            ASSERT_EQ(full.j_coverage_status.size(), j_masks.size());
+            EXPECT_EQ(full.j_coverage_status.count(), static_cast<size_t>(full.covered_j_count));
+
+            std::vector<int> expected_uncovered;
+            for (size_t i = 0; i < j_masks.size(); ++i) {
+                if (!full.j_coverage_status[i]) expected_uncovered.push_back(static_cast<int>(i));
+            }
+
+            for (auto* calc : {coverageCalc.get(), parallel_calc.get()}) {
+                std::vector<CoverageResult> results = {
+                    calc->calculateCoverage(k_groups, j_masks, 3, mode, 4, CoverageDetail::RatioOnly),
+                    calc->calculateCoverage(k_groups, j_masks, 3, mode, 4, CoverageDetail::UncoveredList),
+                    calc->calculateCoverage(k_lists, samples, 5, 3, mode, 4, CoverageDetail::RatioOnly),
+                    calc->calculateCoverage(k_lists, samples, 5, 3, mode, 4, CoverageDetail::UncoveredList),
+                    calc->verifyCoverage(k_groups, j_masks, 3, mode, 4, CoverageDetail::UncoveredList),
+                };
+                for (const auto& result : results) {
+                    EXPECT_EQ(result.covered_j_count, full.covered_j_count) << "k组数 " << count;
+                    EXPECT_DOUBLE_EQ(result.coverage_ratio, full.coverage_ratio);
+                    EXPECT_TRUE(result.j_coverage_status.empty());
+                    EXPECT_TRUE(result.j_covered_s_counts.empty());
+                    if (result.detail == CoverageDetail::UncoveredList) {
+                        EXPECT_EQ(result.uncovered_j_indices, expected_uncovered) << "k组数 " << count;
+                    } else {
+                        EXPECT_TRUE(result.uncovered_j_indices.empty());
+                    }
+                }
+            }
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -131,7 +131,7 @@ protected:
                 std::cout << elem << " ";
             }
             std::cout << "} - " << (result.j_coverage_status[i] ? "已覆盖" : "未覆盖");
-            std::cout << " (覆盖的S子集数: " << result.j_covered_s_counts[i] << ")" << std::endl;
+            std::cout << " (覆盖的S子集数: " << static_cast<int>(result.j_covered_s_counts[i]) << ")" << std::endl;
         }
 
         std::cout << "\n覆盖率: " << result.coverage_ratio;
@@ -328,7 +328,7 @@ TEST_F(CoverageCalculatorTest, BasicCoverageCalculation) {
                 std::cout << num << " ";
             }
             std::cout << "} - 覆盖状态: " << (result.j_coverage_status[j] ? "是" : "否")
-                     << ", 覆盖的s子集数: " << result.j_covered_s_counts[j] << std::endl;
+                     << ", 覆盖的s子集数: " << static_cast<int>(result.j_covered_s_counts[j]) << std::endl;
 
             std::cout << "  s子集覆盖分析:" << std::endl;
             for (const auto& subset : s_subsets[j]) {
@@ -500,7 +500,7 @@ TEST_F(CoverageCalculatorTest, LargeScaleTest) {
         for (size_t j = 0; j < std::min(size_t(5), result.j_coverage_status.size()); ++j) {
             std::cout << "j组 " << j << ": "
                      << "覆盖状态=" << (result.j_coverage_status[j] ? "是" : "否")
-                     << ", 覆盖的s子集数=" << result.j_covered_s_counts[j]
+                     << ", 覆盖的s子集数=" << static_cast<int>(result.j_covered_s_counts[j])
                      << std::endl;
         }
     }
@@ -585,7 +585,7 @@ TEST_F(CoverageCalculatorTest, ParallelPerformanceTest) {
         for (int j = 0; j < std::min(3, j_count); ++j) {
             std::cout << "j组 " << j << ": "
                      << "覆盖状态=" << (result.j_coverage_status[j] ? "是" : "否")
-                     << ", 覆盖的s子集数=" << result.j_covered_s_counts[j]
+                     << ", 覆盖的s子集数=" << static_cast<int>(result.j_covered_s_counts[j])
                      << std::endl;
         }
     }
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "coverage_kernel.hpp"
+#include "coverage_calculator.hpp"
+#include "combination_generator.hpp"
+#include <random>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+// 随机生成 size 元掩码，样本值取自 [0, n)
+CombinationMask randomMask(std::mt19937_64& rng, int n, int size) {
+    CombinationMask mask = 0;
+    while (maskPopcount(mask) < size) {
+        mask |= CombinationMask(1) << (rng() % n);
+    }
+    return mask;
+}
+
+TEST(CoverageKernelTest, AllLevelsMatchScalar) {
+    const SimdLevel detected = detectSimdLevel();
+    std::cout << "检测到的指令集: " << simdLevelName(detected) << std::endl;
+
+    std::mt19937_64 rng(42);
+    const ModeACoverageKernel scalar = modeACoverageKernelFor(SimdLevel::Scalar);
+    // 覆盖各向量宽度的尾部长度，以及超出 n <= 54 的高位样本值
+    for (size_t jCount : {0u, 1u, 3u, 7u, 9u, 17u, 200u}) {
+        for (int n : {25, 64}) {
+            std::vector<CombinationMask> jGroups(jCount);
+            for (auto& mask : jGroups) mask = randomMask(rng, n, 7);
+            std::vector<CombinationMask> kGroups(15);
+            for (auto& mask : kGroups) mask = randomMask(rng, n, 6);
+
+            for (int s = 1; s <= 7; ++s) {
+                std::vector<char> expected(jCount, 0);
+                scalar(jGroups.data(), jCount, kGroups.data(), kGroups.size(), s, expected.data());
+                for (int level = 1; level <= static_cast<int>(detected); ++level) {
+                    std::vector<char> actual(jCount, 2);
+                    modeACoverageKernelFor(static_cast<SimdLevel>(level))(
+                        jGroups.data(), jCount, kGroups.data(), kGroups.size(), s, actual.data());
+                    EXPECT_EQ(actual, expected) << simdLevelName(static_cast<SimdLevel>(level))
+                                                << " jCount=" << jCount << " n=" << n << " s=" << s;
+                }
+            }
+        }
+    }
+}
+
+TEST(CoverageKernelTest, EmptyKGroupsCoverNothing) {
+    std::vector<CombinationMask> jGroups(10, 0x7f);
+    for (int level = 0; level <= static_cast<int>(detectSimdLevel()); ++level) {
+        std::vector<char> covered(jGroups.size(), 1);
+        modeACoverageKernelFor(static_cast<SimdLevel>(level))(
+            jGroups.data(), jGroups.size(), nullptr, 0, 1, covered.data());
+        EXPECT_EQ(covered, std::vector<char>(jGroups.size(), 0));
+    }
+}
+
+TEST(CoverageKernelTest, CalculatorUsesKernelForModeA) {
+    // n=25, j=7 的完整验证：480700 个j组
+    std::vector<int> samples;
+    for (int i = 1; i <= 25; ++i) samples.push_back(i);
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    const auto jGroups = generator->generateMasks(samples, 7);
+    ASSERT_EQ(jGroups.size(), 480700u);
+
+    std::mt19937_64 rng(3);
+    std::vector<CombinationMask> kGroups(40);
+    for (auto& mask : kGroups) mask = randomMask(rng, 25, 6) << 1;
+
+    auto result = calculator->calculateCoverage(kGroups, jGroups, 3, CoverageMode::CoverMinOneS);
+    std::vector<char> expected(jGroups.size(), 0);
+    modeACoverageKernelFor(SimdLevel::Scalar)(
+        jGroups.data(), jGroups.size(), kGroups.data(), kGroups.size(), 3, expected.data());
+    int expectedCount = 0;
+    for (size_t i = 0; i < jGroups.size(); ++i) {
+        ASSERT_EQ(result.j_coverage_status[i], expected[i] != 0);
+        ASSERT_EQ(result.j_covered_s_counts[i], expected[i]);
+        expectedCount += expected[i];
+    }
+    EXPECT_EQ(result.covered_j_count, expectedCount);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "coverage_tracker.hpp"
+#include "coverage_calculator.hpp"
+#include "combination_generator.hpp"
+#include <random>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+// 随机添加/移除k组，每一步与无状态的覆盖计算结果比较
+void checkAgainstCalculator(CoverageMode mode, int minCoverageCount) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const int k = 6, j = 5, s = 3;
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    const auto candidates = generator->generateMasks(samples, k);
+    const auto jGroups = generator->generateMasks(samples, j);
+
+    auto tracker = CoverageTracker::create(samples, j, s, mode, minCoverageCount);
+    ASSERT_EQ(tracker->jGroupCount(), jGroups.size());
+    EXPECT_EQ(tracker->uncoveredCount(), jGroups.size());
+
+    std::mt19937 rng(7);
+    std::vector<CombinationMask> selected;
+    for (int step = 0; step < 60; ++step) {
+        if (!selected.empty() && rng() % 3 == 0) {
+            size_t idx = rng() % selected.size();
+            tracker->removeGroup(selected[idx]);
+            selected.erase(selected.begin() + idx);
+        } else {
+            CombinationMask kGroup = candidates[rng() % candidates.size()];
+            auto before = calculator->calculateCoverage(selected, jGroups, s, mode, minCoverageCount);
+            const size_t gain = tracker->marginalGain(kGroup);
+            tracker->addGroup(kGroup);
+            selected.push_back(kGroup);
+            auto after = calculator->calculateCoverage(selected, jGroups, s, mode, minCoverageCount);
+            ASSERT_EQ(gain, static_cast<size_t>(after.covered_j_count - before.covered_j_count));
+        }
+
+        auto expected = calculator->calculateCoverage(selected, jGroups, s, mode, minCoverageCount);
+        ASSERT_EQ(tracker->uncoveredCount(), jGroups.size() - expected.covered_j_count) << "step " << step;
+        ASSERT_EQ(tracker->isFeasible(), expected.covered_j_count == expected.total_j_count);
+        ASSERT_EQ(tracker->groupCount(), selected.size());
+        for (size_t i = 0; i < jGroups.size(); ++i) {
+            ASSERT_EQ(tracker->isCovered(i), expected.j_coverage_status[i]) << "step " << step << ", j " << i;
+            if (mode == CoverageMode::CoverMinNS) {
+                ASSERT_EQ(tracker->coveredCount(i), expected.j_covered_s_counts[i]);
+            }
+        }
+    }
+}
+
+TEST(CoverageTrackerTest, ModeAMatchesCalculator) {
+    checkAgainstCalculator(CoverageMode::CoverMinOneS, 1);
+}
+
+TEST(CoverageTrackerTest, ModeBMatchesCalculator) {
+    checkAgainstCalculator(CoverageMode::CoverMinNS, 4);
+}
+
+TEST(CoverageTrackerTest, ModeCMatchesCalculator) {
+    checkAgainstCalculator(CoverageMode::CoverAllS, 1);
+}
+
+TEST(CoverageTrackerTest, PartialAndDuplicateJGroupsMatchCalculator) {
+    // j组为部分组合（含重复），k组含j组并集之外的样本：分别走哈希表与组合数下标两种索引
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    const auto candidates = generator->generateMasks(samples, 6);
+    const auto all = generator->generateMasks(samples, 4);
+    const auto dense = generator->generateMasks({2, 3, 4, 5, 6, 7, 8}, 4);
+
+    std::vector<CombinationMask> sparse;
+    for (size_t i = 0; i < all.size(); i += 3) sparse.push_back(all[i]);
+    sparse.push_back(sparse.front());
+    auto nearlyComplete = dense;
+    nearlyComplete.pop_back();
+    nearlyComplete.push_back(dense.front());
+
+    for (const auto& jGroups : {sparse, nearlyComplete}) {
+        for (int s : {2, 4}) {
+            for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS}) {
+                auto tracker = CoverageTracker::create(jGroups, s, mode, 3);
+                std::vector<CombinationMask> selected;
+                for (size_t c = 0; c < candidates.size(); c += 37) {
+                    auto before = calculator->calculateCoverage(selected, jGroups, s, mode, 3);
+                    const size_t gain = tracker->marginalGain(candidates[c]);
+                    tracker->addGroup(candidates[c]);
+                    selected.push_back(candidates[c]);
+                    auto after = calculator->calculateCoverage(selected, jGroups, s, mode, 3);
+                    ASSERT_EQ(gain, static_cast<size_t>(after.covered_j_count - before.covered_j_count));
+                    ASSERT_EQ(tracker->uncoveredCount(), jGroups.size() - after.covered_j_count);
+                    for (size_t i = 0; i < jGroups.size(); ++i) {
+                        ASSERT_EQ(tracker->isCovered(i), after.j_coverage_status[i]) << "s " << s << ", j " << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(CoverageTrackerTest, FeasibilityAndErrors) {
+    // 一个包含全部样本的k组满足所有模式
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7};
+    auto tracker = CoverageTracker::create(samples, 4, 2, CoverageMode::CoverAllS);
+    EXPECT_FALSE(tracker->isFeasible());
+    EXPECT_EQ(tracker->marginalGain(samples), 35u);
+    tracker->addGroup(samples);
+    EXPECT_TRUE(tracker->isFeasible());
+
+    // 重复添加按多重集计数，移除一次后仍可行
+    tracker->addGroup(samples);
+    tracker->removeGroup(samples);
+    EXPECT_TRUE(tracker->isFeasible());
+    tracker->removeGroup(samples);
+    EXPECT_EQ(tracker->uncoveredCount(), 35u);
+
+    EXPECT_THROW(tracker->removeGroup(samples), AlgorithmError);
+    EXPECT_THROW(CoverageTracker::create(samples, 3, 4, CoverageMode::CoverMinNS, 1), AlgorithmError);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "covered_subset_table.hpp"
+#include "coverage_calculator.hpp"
+#include "combination_generator.hpp"
+#include <random>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+std::vector<int> range(int first, int last) {
+    std::vector<int> values;
+    for (int v = first; v <= last; ++v) values.push_back(v);
+    return values;
+}
+
+// 随机选取 size 个样本组成k组
+std::vector<CombinationMask> randomGroups(std::mt19937& rng, const std::vector<int>& samples, int size, size_t count) {
+    std::vector<CombinationMask> groups(count);
+    for (auto& group : groups) {
+        while (maskPopcount(group) < size) {
+            group |= elementBit(samples[rng() % samples.size()]);
+        }
+    }
+    return groups;
+}
+
+TEST(CoveredSubsetTableTest, ContainsMatchesBruteForce) {
+    std::mt19937 rng(5);
+    // 12 个样本按子集掩码直接寻址，30 个样本按组合数下标寻址
+    for (int n : {12, 30}) {
+        const auto samples = range(1, n);
+        const auto kGroups = randomGroups(rng, samples, 6, 20);
+        const auto table = CoveredSubsetTable::build(kGroups, toMask(samples), 3);
+        EXPECT_EQ(table.universeSize(), n);
+        EXPECT_EQ(table.directAddressed(), n <= CoveredSubsetTable::DIRECT_MAX_BITS);
+        EXPECT_EQ(table.byteCount(), CoveredSubsetTable::estimateBytes(n, 3));
+
+        auto generator = CombinationGenerator::create(Config());
+        for (CombinationMask subset : generator->generateMasks(samples, 3)) {
+            bool expected = false;
+            for (CombinationMask kGroup : kGroups) {
+                expected = expected || isSubmask(kGroup, subset);
+            }
+            ASSERT_EQ(table.contains(subset), expected) << "n=" << n;
+        }
+    }
+}
+
+TEST(CoveredSubsetTableTest, VerifyCoverageMatchesCalculateCoverage) {
+    std::mt19937 rng(11);
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+
+    for (int n : {10, 28}) {
+        const auto samples = range(1, n);
+        const auto jGroups = generator->generateMasks(samples, 5);
+        const auto kGroups = randomGroups(rng, samples, 7, n * 6);
+
+        for (CoverageMode mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+            for (int s : {2, 3, 4}) {
+                auto expected = calculator->calculateCoverage(kGroups, jGroups, s, mode, 3);
+                auto actual = calculator->verifyCoverage(kGroups, jGroups, s, mode, 3);
+                EXPECT_EQ(actual.covered_j_count, expected.covered_j_count) << "n=" << n << " s=" << s;
+                EXPECT_EQ(actual.total_groups, expected.total_groups);
+                EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+                EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+            }
+        }
+    }
+}
+
+TEST(CoveredSubsetTableTest, FallsBackWhenTableExceedsBudget) {
+    Config config;
+    config.maxCacheBytes = 16;
+    auto calculator = CoverageCalculator::create(config);
+    std::vector<CombinationMask> kGroups = {toMask({1, 2, 3, 4, 5, 6})};
+    std::vector<CombinationMask> jGroups = {toMask({1, 2, 3, 4}), toMask({1, 2, 7, 8})};
+
+    auto result = calculator->verifyCoverage(kGroups, jGroups, 2, CoverageMode::CoverAllS);
+    ASSERT_EQ(result.j_coverage_status.size(), 2u);
+    EXPECT_TRUE(result.j_coverage_status[0]);
+    EXPECT_FALSE(result.j_coverage_status[1]);
+    EXPECT_EQ(result.j_covered_s_counts, std::vector<uint8_t>({6, 1}));
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
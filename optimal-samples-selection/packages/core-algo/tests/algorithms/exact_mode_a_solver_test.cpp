@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "mode_a_solver.hpp"
+#include "combination_generator.hpp"
+#include "set_operations.hpp"
+#include "coverage_calculator.hpp"
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+std::vector<int> firstSamples(int n) {
+    std::vector<int> samples(n);
+    std::iota(samples.begin(), samples.end(), 1);
+    return samples;
+}
+
+std::shared_ptr<ModeASolver> makeSolver(const Config& config, bool exact = true) {
+    std::shared_ptr<CombinationGenerator> combGen = CombinationGenerator::create(config);
+    std::shared_ptr<SetOperations> setOps = SetOperations::create(config);
+    std::shared_ptr<CoverageCalculator> covCalc = CoverageCalculator::create(config);
+    return exact ? createExactModeASolver(combGen, setOps, covCalc, config)
+                 : createGreedyModeASolver(combGen, setOps, covCalc, config);
+}
+
+bool coversAll(const std::vector<std::vector<int>>& groups, const std::vector<int>& samples, int j, int s) {
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    return calculator->isFeasible(toMasks(groups), generator->generateMasks(samples, j), s, CoverageMode::CoverMinOneS);
+}
+
+// 穷举：按组数从小到大枚举候选k组的组合，返回能覆盖全部j组的最小组数
+int bruteForceMinimum(const std::vector<int>& samples, int k, int j, int s) {
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    const auto candidates = generator->generateMasks(samples, k);
+    const auto jGroups = generator->generateMasks(samples, j);
+    for (int size = 1; size <= static_cast<int>(candidates.size()); ++size) {
+        std::vector<int> idx(size);
+        std::iota(idx.begin(), idx.end(), 0);
+        const int total = static_cast<int>(candidates.size());
+        while (true) {
+            std::vector<CombinationMask> chosen;
+            for (int i : idx) chosen.push_back(candidates[i]);
+            if (calculator->isFeasible(chosen, jGroups, s, CoverageMode::CoverMinOneS)) return size;
+            int pos = size - 1;
+            while (pos >= 0 && idx[pos] == total - size + pos) --pos;
+            if (pos < 0) break;
+            ++idx[pos];
+            for (int i = pos + 1; i < size; ++i) idx[i] = idx[i - 1] + 1;
+        }
+    }
+    return -1;
+}
+
+TEST(ExactModeASolverTest, MatchesBruteForceOnSmallInstances) {
+    struct Params { int n, k, j, s; };
+    auto solver = makeSolver(Config());
+    for (const auto& p : std::vector<Params>{{7, 4, 4, 3}, {7, 5, 5, 4}, {7, 5, 4, 3}, {8, 5, 4, 3}, {8, 6, 5, 4}}) {
+        SCOPED_TRACE("n=" + std::to_string(p.n) + " k=" + std::to_string(p.k) +
+                     " j=" + std::to_string(p.j) + " s=" + std::to_string(p.s));
+        const auto samples = firstSamples(p.n);
+        auto solution = solver->solve(45, p.n, samples, p.k, p.s, p.j);
+        EXPECT_EQ(solution.status, Status::Success);
+        EXPECT_TRUE(solution.isOptimal);
+        EXPECT_TRUE(coversAll(solution.groups, samples, p.j, p.s));
+        EXPECT_EQ(solution.totalGroups, bruteForceMinimum(samples, p.k, p.j, p.s));
+        EXPECT_EQ(solution.lowerBound, solution.totalGroups);
+        EXPECT_DOUBLE_EQ(solution.optimalityGap, 0.0);
+    }
+}
+
+TEST(ExactModeASolverTest, ProvesKnownOptimum) {
+    // n=8, k=6, j=6, s=5 的最优解为4组
+    const auto samples = firstSamples(8);
+    auto solution = makeSolver(Config())->solve(45, 8, samples, 6, 5, 6);
+    EXPECT_EQ(solution.status, Status::Success);
+    EXPECT_TRUE(solution.isOptimal);
+    EXPECT_EQ(solution.totalGroups, 4);
+    EXPECT_TRUE(coversAll(solution.groups, samples, 6, 5));
+}
+
+TEST(ExactModeASolverTest, NeverWorseThanGreedy) {
+    const auto samples = firstSamples(10);
+    auto greedy = makeSolver(Config(), false)->solve(45, 10, samples, 6, 4, 6);
+    auto exact = makeSolver(Config())->solve(45, 10, samples, 6, 4, 6);
+    EXPECT_EQ(exact.status, Status::Success);
+    EXPECT_LE(exact.totalGroups, greedy.totalGroups);
+    EXPECT_TRUE(coversAll(exact.groups, samples, 6, 4));
+
+    auto generator = CombinationGenerator::create(Config());
+    auto groups = makeSolver(Config())->performSelection(
+        generator->generate(samples, 6), generator->generate(samples, 6), {}, 6, 4);
+    EXPECT_EQ(static_cast<int>(groups.size()), exact.totalGroups);
+}
+
+TEST(ExactModeASolverTest, TimeLimitReturnsIncumbentAndGap) {
+    Config config;
+    config.timeLimit = 0.05;
+    const auto samples = firstSamples(12);
+    auto solution = makeSolver(config)->solve(45, 12, samples, 6, 5, 6);
+
+    EXPECT_EQ(solution.status, Status::Timeout);
+    EXPECT_FALSE(solution.isOptimal);
+    EXPECT_TRUE(coversAll(solution.groups, samples, 6, 5));
+    EXPECT_GT(solution.lowerBound, 0);
+    EXPECT_LT(solution.lowerBound, solution.totalGroups);
+    EXPECT_GT(solution.optimalityGap, 0.0);
+    EXPECT_LE(solution.optimalityGap, 1.0);
+}
+
+TEST(ExactModeASolverTest, PerformSelectionHonoursTimeLimit) {
+    Config config;
+    config.timeLimit = 0.05;
+    const auto samples = firstSamples(12);
+    auto generator = CombinationGenerator::create(config);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto groups = makeSolver(config)->performSelection(
+        generator->generate(samples, 6), generator->generate(samples, 6), {}, 6, 5);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(seconds, 5.0);
+    EXPECT_TRUE(coversAll(groups, samples, 6, 5));
+}
+
+TEST(ExactModeASolverTest, UncoverableInstanceReportsNoSolution) {
+    // s > k 时任何k组都不能覆盖j组
+    auto solution = makeSolver(Config())->solve(45, 8, firstSamples(8), 3, 4, 5);
+    EXPECT_EQ(solution.status, Status::NoSolution);
+    EXPECT_LT(solution.coverageRatio, 1.0);
+}
+
+TEST(ExactModeASolverTest, RejectsInstancesBeyondMemoryBudget) {
+    Config config;
+    config.maxCacheBytes = 0;
+    auto solution = makeSolver(config)->solve(45, 8, firstSamples(8), 6, 5, 6);
+    EXPECT_EQ(solution.status, Status::Error);
+    EXPECT_THROW(makeSolver(config)->performSelection({{1, 2, 3}}, {{1, 2, 3}}, {}, 3, 2), AlgorithmError);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "generation_cache.hpp"
+#include "combination_generator.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+using Combinations = GenerationCache::Combinations;
+
+std::shared_ptr<const Combinations> makeValue(size_t count, int r) {
+    return std::make_shared<const Combinations>(count, std::vector<int>(r, 1));
+}
+
+TEST(GenerationCacheTest, HitMissAndContentKeys) {
+    auto cache = GenerationCache::create(10, 1 << 20);
+
+    EXPECT_EQ(cache->find({1, 2, 3}, 2), nullptr);
+    cache->insert({1, 2, 3}, 2, makeValue(3, 2));
+    ASSERT_NE(cache->find({1, 2, 3}, 2), nullptr);
+
+    // 元素个数相同但内容不同时不应命中
+    EXPECT_EQ(cache->find({4, 5, 6}, 2), nullptr);
+    EXPECT_EQ(cache->find({1, 2, 3}, 1), nullptr);
+
+    auto stats = cache->stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_GT(stats.bytes, 0u);
+}
+
+TEST(GenerationCacheTest, EvictsLeastRecentlyUsed) {
+    auto cache = GenerationCache::create(2, 1 << 20);
+    cache->insert({1}, 1, makeValue(1, 1));
+    cache->insert({2}, 1, makeValue(1, 1));
+
+    // 访问 {1} 后插入新条目，应淘汰最久未使用的 {2}
+    ASSERT_NE(cache->find({1}, 1), nullptr);
+    cache->insert({3}, 1, makeValue(1, 1));
+
+    EXPECT_NE(cache->find({1}, 1), nullptr);
+    EXPECT_EQ(cache->find({2}, 1), nullptr);
+    EXPECT_NE(cache->find({3}, 1), nullptr);
+    EXPECT_EQ(cache->stats().evictions, 1u);
+}
+
+TEST(GenerationCacheTest, RespectsByteBudget) {
+    const size_t budget = 64 * 1024;
+    auto cache = GenerationCache::create(1000, budget);
+
+    for (int i = 0; i < 20; ++i) {
+        cache->insert({i}, 4, makeValue(200, 4));
+        EXPECT_LE(cache->stats().bytes, budget);
+    }
+    EXPECT_GT(cache->stats().evictions, 0u);
+
+    // 超出整个预算的结果不缓存
+    cache->insert({99}, 4, makeValue(100000, 4));
+    EXPECT_EQ(cache->find({99}, 4), nullptr);
+}
+
+TEST(GenerationCacheTest, ConcurrentAccess) {
+    auto cache = GenerationCache::create(16, 1 << 20);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 500; ++i) {
+                int key = (i + t) % 32;
+                if (!cache->find({key}, 1)) {
+                    cache->insert({key}, 1, makeValue(4, 1));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = cache->stats();
+    EXPECT_EQ(stats.hits + stats.misses, 2000u);
+    EXPECT_LE(stats.entries, 16u);
+}
+
+TEST(GenerationCacheTest, GeneratorUsesSharedCache) {
+    Config config;
+    config.enableCache = true;
+    config.maxCacheSize = 7;  // 独立的限制组合，避免与其他测试共享实例
+    auto first = CombinationGenerator::create(config);
+    auto second = CombinationGenerator::create(config);
+
+    auto expected = first->generate({1, 2, 3, 4, 5}, 3);
+    auto before = second->getCacheStats();
+
+    // 另一个生成器复用同一结果
+    EXPECT_EQ(second->generate({1, 2, 3, 4, 5}, 3), expected);
+    EXPECT_EQ(second->getCacheStats().hits, before.hits + 1);
+
+    // 不同元素必须重新生成，而不是返回同尺寸的缓存结果
+    auto other = second->generate({6, 7, 8, 9, 10}, 3);
+    EXPECT_EQ(other.front(), (std::vector<int>{6, 7, 8}));
+
+    // 未启用缓存时统计全为0
+    auto uncached = CombinationGenerator::create(Config());
+    uncached->generate({1, 2, 3}, 2);
+    EXPECT_EQ(uncached->getCacheStats().hits + uncached->getCacheStats().misses, 0u);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
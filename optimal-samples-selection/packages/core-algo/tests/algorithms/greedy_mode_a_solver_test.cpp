@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "mode_a_solver.hpp"
+#include "combination_generator.hpp"
+#include "set_operations.hpp"
+#include "coverage_calculator.hpp"
+#include <numeric>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+struct Params {
+    int n, k, j, s;
+};
+
+std::vector<int> firstSamples(int n) {
+    std::vector<int> samples(n);
+    std::iota(samples.begin(), samples.end(), 1);
+    return samples;
+}
+
+std::shared_ptr<ModeASolver> makeSolver(const Config& config) {
+    return createGreedyModeASolver(
+        CombinationGenerator::create(config),
+        SetOperations::create(config),
+        CoverageCalculator::create(config),
+        config);
+}
+
+// 解覆盖全部j组，且每个k组都至少独自覆盖一个j组（没有冗余k组）
+void expectMinimalCover(const DetailedSolution& solution, const std::vector<int>& samples, int j, int s) {
+    auto generator = CombinationGenerator::create(Config());
+    auto calculator = CoverageCalculator::create(Config());
+    const auto jGroups = generator->generateMasks(samples, j);
+    const auto selected = toMasks(solution.groups);
+
+    EXPECT_EQ(solution.status, Status::Success);
+    EXPECT_DOUBLE_EQ(solution.coverageRatio, 1.0);
+    EXPECT_EQ(solution.totalGroups, static_cast<int>(selected.size()));
+    EXPECT_TRUE(calculator->isFeasible(selected, jGroups, s, CoverageMode::CoverMinOneS));
+
+    for (size_t i = 0; i < selected.size(); ++i) {
+        auto others = selected;
+        others.erase(others.begin() + i);
+        EXPECT_FALSE(calculator->isFeasible(others, jGroups, s, CoverageMode::CoverMinOneS))
+            << "第 " << i << " 个k组是冗余的";
+    }
+}
+
+TEST(GreedyModeASolverTest, CoversAllJGroupsWithoutRedundantGroups) {
+    const std::vector<Params> cases = {
+        {7, 6, 5, 5}, {8, 6, 6, 5}, {9, 6, 5, 4}, {10, 6, 6, 4}, {11, 6, 5, 3}, {12, 6, 6, 4}, {12, 5, 4, 3},
+    };
+    auto solver = makeSolver(Config());
+    for (const auto& p : cases) {
+        SCOPED_TRACE("n=" + std::to_string(p.n) + " k=" + std::to_string(p.k) +
+                     " j=" + std::to_string(p.j) + " s=" + std::to_string(p.s));
+        const auto samples = firstSamples(p.n);
+        auto solution = solver->solve(45, p.n, samples, p.k, p.s, p.j);
+        expectMinimalCover(solution, samples, p.j, p.s);
+        EXPECT_FALSE(solution.isOptimal);
+        for (const auto& group : solution.groups) {
+            EXPECT_EQ(group.size(), static_cast<size_t>(p.k));
+        }
+    }
+}
+
+TEST(GreedyModeASolverTest, FallbackWithoutIncidenceMatrixMatches) {
+    const auto samples = firstSamples(10);
+    auto solver = makeSolver(Config());
+
+    Config noCache;
+    noCache.maxCacheBytes = 0;
+    auto fallback = makeSolver(noCache);
+
+    for (const auto& p : std::vector<Params>{{10, 6, 6, 4}, {10, 5, 5, 3}}) {
+        auto expected = solver->solve(45, p.n, samples, p.k, p.s, p.j);
+        auto actual = fallback->solve(45, p.n, samples, p.k, p.s, p.j);
+        EXPECT_EQ(actual.groups, expected.groups);
+    }
+}
+
+TEST(GreedyModeASolverTest, PerformSelectionMatchesSolve) {
+    const auto samples = firstSamples(9);
+    auto generator = CombinationGenerator::create(Config());
+    auto solver = makeSolver(Config());
+
+    auto solution = solver->solve(45, 9, samples, 6, 4, 5);
+    auto groups = solver->performSelection(
+        generator->generate(samples, 6), generator->generate(samples, 5), {}, 5, 4);
+    EXPECT_EQ(groups, solution.groups);
+}
+
+TEST(GreedyModeASolverTest, UncoverableInstanceReportsNoSolution) {
+    // s > k 时任何k组都不能覆盖j组
+    auto solver = makeSolver(Config());
+    auto solution = solver->solve(45, 8, firstSamples(8), 3, 4, 5);
+    EXPECT_EQ(solution.status, Status::NoSolution);
+    EXPECT_LT(solution.coverageRatio, 1.0);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "incidence_matrix.hpp"
+#include "combination_generator.hpp"
+#include "combinadic.hpp"
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+// 逐个s子集检查的参考实现：k组是否覆盖j组中至少 required 个s子集
+bool referenceCovers(CombinationMask kGroup, CombinationMask jGroup, int s, int required) {
+    int covered = 0;
+    forEachSubmaskOfSize(jGroup, s, [&](CombinationMask subset) {
+        if (isSubmask(kGroup, subset)) ++covered;
+        return true;
+    });
+    return covered >= required;
+}
+
+TEST(IncidenceMatrixTest, MatchesSubsetEnumeration) {
+    auto generator = CombinationGenerator::create(Config());
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const int k = 6, j = 5, s = 3;
+    const auto kMasks = generator->generateMasks(samples, k);
+    const auto jMasks = generator->generateMasks(samples, j);
+
+    struct Case { CoverageMode mode; int minCount; int required; };
+    for (const Case& c : {Case{CoverageMode::CoverMinOneS, 1, 1},
+                          Case{CoverageMode::CoverMinNS, 4, 4},
+                          Case{CoverageMode::CoverAllS, 1, static_cast<int>(binomial(j, s))}}) {
+        auto incidence = IncidenceMatrix::forCoverage(kMasks, jMasks, j, s, c.mode, c.minCount, 3);
+        ASSERT_EQ(incidence.rowCount(), kMasks.size());
+        ASSERT_EQ(incidence.columnCount(), jMasks.size());
+        for (size_t r = 0; r < kMasks.size(); ++r) {
+            for (size_t col = 0; col < jMasks.size(); ++col) {
+                ASSERT_EQ(incidence.covers(r, col), referenceCovers(kMasks[r], jMasks[col], s, c.required))
+                    << "r=" << r << " c=" << col;
+            }
+        }
+    }
+}
+
+TEST(IncidenceMatrixTest, TransposeAndDegrees) {
+    // 列数跨越多个字，检查转置视图与度数
+    std::vector<CombinationMask> rows;
+    std::vector<CombinationMask> columns;
+    for (int v = 0; v < 3; ++v) rows.push_back(elementBit(v) | elementBit(v + 1));
+    for (int c = 0; c < 130; ++c) columns.push_back(elementBit(c % 4));
+
+    auto incidence = IncidenceMatrix::build(rows, columns, 1, 2);
+    EXPECT_EQ(incidence.wordsPerRow(), 3u);
+    EXPECT_EQ(incidence.wordsPerColumn(), 1u);
+    for (size_t r = 0; r < rows.size(); ++r) {
+        size_t degree = 0;
+        for (size_t c = 0; c < columns.size(); ++c) {
+            const bool fromColumn = (incidence.column(c)[r / 64] >> (r % 64)) & 1;
+            EXPECT_EQ(incidence.covers(r, c), fromColumn);
+            degree += incidence.covers(r, c);
+        }
+        EXPECT_EQ(incidence.rowDegree(r), degree);
+    }
+    // 值为0的列只被第0行满足
+    EXPECT_EQ(incidence.columnDegree(0), 1u);
+    EXPECT_EQ(incidence.columnDegree(1), 2u);
+}
+
+TEST(IncidenceMatrixTest, AdjacencyAndCoverageQueries) {
+    std::vector<std::vector<size_t>> adjacency = {{0, 2, 70}, {2, 3}, {}};
+    auto incidence = IncidenceMatrix::fromAdjacency(adjacency, 80);
+    EXPECT_TRUE(incidence.covers(0, 70));
+    EXPECT_FALSE(incidence.covers(2, 0));
+    EXPECT_EQ(incidence.columnDegree(2), 2u);
+
+    auto covered = incidence.coveredColumns({0});
+    EXPECT_EQ(incidence.countUncovered(1, covered.data()), 1u);
+    incidence.mergeRow(1, covered.data());
+    EXPECT_EQ(incidence.countUncovered(0, covered.data()), 0u);
+
+    EXPECT_THROW(IncidenceMatrix::fromAdjacency({{80}}, 80), AlgorithmError);
+}
+
+TEST(IncidenceMatrixTest, RequiredIntersection) {
+    EXPECT_EQ(IncidenceMatrix::requiredIntersection(6, 4, CoverageMode::CoverMinOneS), 4);
+    EXPECT_EQ(IncidenceMatrix::requiredIntersection(6, 4, CoverageMode::CoverAllS), 6);
+    // C(4,4)=1, C(5,4)=5, C(6,4)=15
+    EXPECT_EQ(IncidenceMatrix::requiredIntersection(6, 4, CoverageMode::CoverMinNS, 2), 5);
+    EXPECT_EQ(IncidenceMatrix::requiredIntersection(6, 4, CoverageMode::CoverMinNS, 15), 6);
+    EXPECT_EQ(IncidenceMatrix::requiredIntersection(6, 4, CoverageMode::CoverMinNS, 16), 7);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -795,6 +795,60 @@ TEST_F(ModeASetCoverSolverTest, Example9Test) {
     std::cout << "=== 测试完成 ===" << std::endl;
 }
 
+// 并行扩展beam：不同线程数下的解与串行结果完全一致
+TEST_F(ModeASetCoverSolverTest, ParallelBeamExpansionIsDeterministic) {
+    int n = 9;
+    int k = 6;
+    int j = 5;
+    int s = 4;
+    std::vector<int> samples;
+    for (int i = 1; i <= n; i++) {
+        samples.push_back(i);
+    }
+
+    auto serial = m_solver->solve(45, n, samples, k, s, j);
+    ASSERT_EQ(serial.status, Status::Success);
+
+    for (int threads : {2, 3, 4}) {
+        Config config = m_config;
+        config.enableParallel = true;
+        config.threadCount = threads;
+        auto solver = createModeASolver(m_combGen, m_setOps, m_covCalc, config);
+        auto parallel = solver->solve(45, n, samples, k, s, j);
+        EXPECT_EQ(parallel.groups, serial.groups) << "线程数 " << threads;
+    }
+}
+
+// 固定当前 beam 搜索的求解结果（选出的k组及其顺序），后续改动引起的变化会在此暴露
+// 注意：beam 状态改为位集与增量评分后，选出的k组与原实现不同，只有组数与原实现一致
+TEST_F(ModeASetCoverSolverTest, BeamSearchResultsArePinned) {
+    struct Case {
+        int n, k, j, s;
+        std::vector<std::vector<int>> groups;
+    };
+    const std::vector<Case> cases = {
+        {8, 6, 6, 5, {{1, 2, 3, 4, 5, 6}, {1, 3, 4, 5, 6, 7}, {2, 3, 4, 5, 6, 7}, {1, 2, 4, 5, 7, 8},
+                      {1, 2, 3, 6, 7, 8}}},
+        {9, 6, 5, 4, {{1, 2, 3, 4, 5, 6}, {1, 3, 4, 5, 7, 8}, {1, 2, 6, 7, 8, 9}, {3, 4, 5, 7, 8, 9},
+                      {1, 2, 3, 4, 5, 9}, {1, 3, 4, 6, 7, 8}, {2, 3, 5, 6, 8, 9}, {2, 4, 5, 6, 7, 8},
+                      {1, 4, 5, 6, 7, 9}, {1, 2, 3, 4, 6, 7}}},
+        {10, 6, 6, 4, {{1, 2, 3, 4, 5, 6}, {2, 3, 4, 7, 9, 10}, {1, 6, 7, 8, 9, 10}, {1, 4, 5, 6, 9, 10},
+                       {2, 4, 5, 6, 7, 8}, {2, 3, 4, 8, 9, 10}, {1, 3, 5, 7, 8, 9}, {2, 3, 5, 6, 9, 10},
+                       {1, 2, 3, 4, 5, 7}}},
+        {12, 6, 6, 3, {{1, 2, 3, 5, 10, 11}, {4, 6, 8, 9, 10, 12}, {2, 3, 5, 7, 8, 12}, {2, 4, 5, 6, 7, 11},
+                       {1, 4, 7, 8, 9, 11}, {1, 6, 9, 10, 11, 12}, {1, 2, 3, 5, 6, 9}}},
+    };
+
+    for (const auto& c : cases) {
+        std::vector<int> samples(c.n);
+        std::iota(samples.begin(), samples.end(), 1);
+        auto solution = m_solver->solve(45, c.n, samples, c.k, c.s, c.j);
+        EXPECT_EQ(solution.status, Status::Success);
+        EXPECT_EQ(solution.groups, c.groups)
+            << "n=" << c.n << " k=" << c.k << " j=" << c.j << " s=" << c.s;
+    }
+}
+
 } // namespace testing
 } // namespace core_algo 
 
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "parameter_kernels.hpp"
+#include "combination_generator.hpp"
+#include "combination_visitor.hpp"
+#include <numeric>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+TEST(ParameterKernelsTest, DispatchCoversParameterGrid) {
+    for (int r = 1; r <= MAX_KERNEL_SIZE; ++r) {
+        EXPECT_NE(enumerateKernelFor(r), nullptr);
+    }
+    for (int j = 1; j <= MAX_KERNEL_SIZE; ++j) {
+        for (int s = 1; s <= j; ++s) {
+            EXPECT_NE(subsetKernelFor(j, s), nullptr);
+            EXPECT_NE(coverageCountKernelFor(j, s), nullptr);
+        }
+    }
+
+    // 超出网格时回退到通用实现
+    EXPECT_EQ(enumerateKernelFor(0), nullptr);
+    EXPECT_EQ(enumerateKernelFor(MAX_KERNEL_SIZE + 1), nullptr);
+    EXPECT_EQ(subsetKernelFor(3, 4), nullptr);
+    EXPECT_EQ(submaskKernelFor(8, 3), nullptr);
+}
+
+TEST(ParameterKernelsTest, KernelsMatchGenericEnumeration) {
+    std::vector<int> samples(10);
+    std::iota(samples.begin(), samples.end(), 3);
+
+    for (int r = 1; r <= MAX_KERNEL_SIZE; ++r) {
+        std::vector<int> flat(binomial(10, r) * r);
+        enumerateKernelFor(r)(samples.data(), 10, flat.data());
+
+        std::vector<int> expected;
+        forEachCombination(samples, r, [&](CombinationView combination) {
+            expected.insert(expected.end(), combination.begin(), combination.end());
+        });
+        EXPECT_EQ(flat, expected) << "r = " << r;
+    }
+
+    std::vector<int> jGroup = {2, 5, 9, 11, 30, 41, 63};
+    for (int j = 3; j <= MAX_KERNEL_SIZE; ++j) {
+        std::vector<int> group(jGroup.begin(), jGroup.begin() + j);
+        for (int s = 1; s <= j; ++s) {
+            std::vector<int> subsets(binomial(j, s) * s);
+            subsetKernelFor(j, s)(group.data(), subsets.data());
+
+            std::vector<CombinationMask> submasks(binomial(j, s));
+            submaskKernelFor(j, s)(toMask(group), submasks.data());
+
+            std::vector<int> expected;
+            std::vector<CombinationMask> expectedMasks;
+            forEachCombination(group, s, [&](CombinationView subset) {
+                expected.insert(expected.end(), subset.begin(), subset.end());
+                expectedMasks.push_back(toMask(subset.toVector()));
+            });
+            EXPECT_EQ(subsets, expected) << "j = " << j << ", s = " << s;
+            EXPECT_EQ(submasks, expectedMasks) << "j = " << j << ", s = " << s;
+        }
+    }
+}
+
+TEST(ParameterKernelsTest, CoverageKernels) {
+    const CombinationMask jGroup = toMask({1, 2, 3, 4, 5});
+    const std::vector<CombinationMask> kGroups = {toMask({1, 2, 3, 8}), toMask({3, 4, 5, 9})};
+
+    // 被覆盖的3元子集：{1,2,3} 与 {3,4,5}
+    EXPECT_EQ(coverageCountKernelFor(5, 3)(jGroup, kGroups.data(), kGroups.size(), INT_MAX), 2);
+    EXPECT_EQ(coverageCountKernelFor(5, 3)(jGroup, kGroups.data(), kGroups.size(), 1), 1);
+
+    // 字典序第一个子集 {1,2,3} 被覆盖，第二个 {1,2,4} 未被覆盖
+    bool allCovered = true;
+    EXPECT_EQ(coveragePrefixKernelFor(5, 3)(jGroup, kGroups.data(), kGroups.size(), allCovered), 1);
+    EXPECT_FALSE(allCovered);
+
+    const CombinationMask everything = toMask({1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(coveragePrefixKernelFor(5, 3)(jGroup, &everything, 1, allCovered), 10);
+    EXPECT_TRUE(allCovered);
+}
+
+TEST(ParameterKernelsTest, CoveredSubsetsKernelMatchesCounting) {
+    std::vector<int> samples = {1, 4, 6, 9, 12, 15, 20, 22, 27};
+    auto generator = CombinationGenerator::create(Config());
+    const std::vector<CombinationMask> kGroups = {
+        toMask({1, 4, 6, 9, 12, 27}), toMask({6, 12, 15, 20, 22}), toMask({1, 9, 20, 22, 27})};
+
+    for (int j = 2; j <= MAX_KERNEL_SIZE; ++j) {
+        for (int s = 1; s <= j; ++s) {
+            auto kernel = coveredSubsetsKernelFor(j, s);
+            ASSERT_NE(kernel, nullptr);
+            for (CombinationMask jGroup : generator->generateMasks(samples, j)) {
+                // 第 c 位与字典序第 c 个s子集是否被覆盖一致
+                uint64_t expected = 0;
+                int c = 0;
+                forEachSubmaskOfSize(jGroup, s, [&](CombinationMask subset) {
+                    for (CombinationMask kGroup : kGroups) {
+                        if (isSubmask(kGroup, subset)) {
+                            expected |= uint64_t(1) << c;
+                            break;
+                        }
+                    }
+                    ++c;
+                    return true;
+                });
+                ASSERT_EQ(kernel(jGroup, kGroups.data(), kGroups.size()), expected)
+                    << "j = " << j << ", s = " << s;
+                ASSERT_EQ(__builtin_popcountll(expected),
+                          coverageCountKernelFor(j, s)(jGroup, kGroups.data(), kGroups.size(), INT_MAX));
+            }
+        }
+    }
+    EXPECT_EQ(coveredSubsetsKernelFor(8, 4), nullptr);
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
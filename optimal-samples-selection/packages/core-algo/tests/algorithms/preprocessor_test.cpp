@@ -131,7 +131,54 @@ protected:
     std::unique_ptr<Preprocessor> m_preprocessor;
 };
 
+// 映射延迟构建，且与逐个展开j组得到的映射一致
+TEST_F(PreprocessorTest, LazySubsetMaps) {
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8};
+    int j = 4;
+    int s = 2;
+
+    auto result = m_preprocessor->preprocess(samples, 8, j, s, 6, CoverageMode::CoverMinOneS);
+    EXPECT_FALSE(result.sToJMap.isBuilt());
+    EXPECT_FALSE(result.jToSMap.isBuilt());
+
+    std::map<std::vector<int>, std::vector<std::vector<int>>> expectedSToJ;
+    std::map<std::vector<int>, std::vector<std::vector<int>>> expectedJToS;
+    for (const auto& jGroup : m_combGen->generate(samples, j)) {
+        for (const auto& sSubset : m_combGen->generate(jGroup, s)) {
+            expectedJToS[jGroup].push_back(sSubset);
+            expectedSToJ[sSubset].push_back(jGroup);
+        }
+    }
+    EXPECT_EQ(result.sToJMap.get(), expectedSToJ);
+    EXPECT_EQ(result.jToSMap.get(), expectedJToS);
+    EXPECT_TRUE(result.sToJMap.isBuilt());
+
+    // 乱序样本走逐个展开j组的路径
+    std::vector<int> shuffled = {5, 1, 8, 3, 2, 7, 4, 6};
+    auto shuffledResult = m_preprocessor->preprocess(shuffled, 8, j, s, 6, CoverageMode::CoverMinOneS);
+    size_t total = 0;
+    for (const auto& [sSubset, jGroups] : shuffledResult.sToJMap) {
+        EXPECT_EQ(jGroups.size(), 15u);  // C(6, 2)
+        total += jGroups.size();
+    }
+    EXPECT_EQ(total, 28u * 15u);
+}
+
 // 小参数测试：n=8, j=4, s=2
+
+TEST_F(PreprocessorTest, ModeAIncidenceRespectsCacheBudget) {
+    // 预算为0时不建立 s子集 × j组关联矩阵，逐个下标统计，选出的s子集不变
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Config noCache;
+    noCache.maxCacheBytes = 0;
+    Preprocessor limited(m_combGen, m_setOps, noCache);
+
+    auto expected = m_preprocessor->preprocess(samples, 10, 6, 3, 6, CoverageMode::CoverMinOneS);
+    auto actual = limited.preprocess(samples, 10, 6, 3, 6, CoverageMode::CoverMinOneS);
+    EXPECT_FALSE(actual.selectedSSubsets.empty());
+    EXPECT_EQ(actual.selectedSSubsets, expected.selectedSSubsets);
+}
+
 TEST_F(PreprocessorTest, SmallParameterTest) {
     std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8};
     int n = 8;
@@ -233,4 +233,20 @@ TEST_F(SetOperationsTest, JaccardSimilarity) {
     EXPECT_DOUBLE_EQ(similarity, 1.0);
     similarity = setOps->calculateJaccardSimilarity(setA, emptySet);
     EXPECT_DOUBLE_EQ(similarity, 0.0);
-} 
\ No newline at end of file
+}
+
+// 位掩码版本的包含关系测试
+TEST_F(SetOperationsTest, MaskContains) {
+    CombinationMask container = toMask({1, 3, 5, 7, 54});
+
+    EXPECT_TRUE(setOps->contains(container, toMask({1, 5, 54})));
+    EXPECT_TRUE(setOps->contains(container, CombinationMask(0)));
+    EXPECT_FALSE(setOps->contains(container, toMask({1, 2})));
+
+    // 与向量版本结果一致
+    std::vector<std::vector<int>> subsets = {{1, 3}, {3, 4}, {5, 7, 54}, {2}};
+    for (const auto& subset : subsets) {
+        EXPECT_EQ(setOps->contains(container, toMask(subset)),
+                  setOps->contains(std::vector<int>{1, 3, 5, 7, 54}, subset));
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "thread_pool.hpp"
+#include "coverage_calculator.hpp"
+#include "combination_generator.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace core_algo {
+namespace {
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnce) {
+    auto pool = ThreadPool::create(4);
+    EXPECT_EQ(pool->threadCount(), 4u);
+
+    for (size_t grain : {size_t(0), size_t(1), size_t(7), size_t(1000)}) {
+        std::vector<std::atomic<int>> visits(1000);
+        pool->parallelFor(0, visits.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                visits[i]++;
+            }
+        }, grain);
+        for (size_t i = 0; i < visits.size(); ++i) {
+            ASSERT_EQ(visits[i].load(), 1) << "grain = " << grain << ", i = " << i;
+        }
+    }
+
+    // 空区间不调用
+    pool->parallelFor(5, 5, [](size_t, size_t) { ADD_FAILURE(); });
+}
+
+TEST(ThreadPoolTest, StealsFromBusyThreads) {
+    auto pool = ThreadPool::create(3);
+    std::mutex mutex;
+    std::set<std::thread::id> workers;
+
+    // 前几块耗时较长，其余块应被其他线程窃取执行
+    pool->parallelFor(0, 24, [&](size_t begin, size_t) {
+        if (begin < 4) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        workers.insert(std::this_thread::get_id());
+    }, 1);
+    EXPECT_GE(workers.size(), 2u);
+}
+
+TEST(ThreadPoolTest, PropagatesExceptionsAndAllowsNesting) {
+    auto pool = ThreadPool::create(2);
+    EXPECT_THROW(pool->parallelFor(0, 100, [](size_t begin, size_t) {
+        if (begin >= 50) throw AlgorithmError("失败");
+    }, 10), AlgorithmError);
+
+    // 在工作线程内嵌套调用同一线程池不会死锁
+    std::atomic<size_t> total{0};
+    pool->parallelFor(0, 8, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            pool->parallelFor(0, 100, [&](size_t b, size_t e) { total += e - b; }, 10);
+        }
+    }, 1);
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(ThreadPoolTest, SharedPoolsFollowConfig) {
+    EXPECT_EQ(ThreadPool::shared(3), ThreadPool::shared(3));
+    EXPECT_NE(ThreadPool::shared(3), ThreadPool::shared(2));
+
+    Config config;
+    config.threadCount = 4;
+    EXPECT_EQ(ThreadPool::forConfig(config)->threadCount(), 1u);  // 未启用并行
+    config.enableParallel = true;
+    EXPECT_EQ(ThreadPool::forConfig(config)->threadCount(), 4u);
+
+    EXPECT_EQ(ThreadPool::chunkSize(1000, 4, 1), 63u);
+    EXPECT_EQ(ThreadPool::chunkSize(10, 4, 100), 100u);
+}
+
+TEST(ThreadPoolTest, ParallelCoverageMatchesSerial) {
+    Config parallel;
+    parallel.enableParallel = true;
+    parallel.threadCount = 4;
+    auto serialCalc = CoverageCalculator::create(Config());
+    auto parallelCalc = CoverageCalculator::create(parallel);
+    auto generator = CombinationGenerator::create(parallel);
+
+    std::vector<int> samples = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    auto kGroups = generator->generateMasks(samples, 6);
+    kGroups.resize(20);
+    auto jGroups = generator->generateMasks(samples, 5);
+
+    for (auto mode : {CoverageMode::CoverMinOneS, CoverageMode::CoverMinNS, CoverageMode::CoverAllS}) {
+        auto expected = serialCalc->calculateCoverage(kGroups, jGroups, 3, mode, 4);
+        auto actual = parallelCalc->calculateCoverage(kGroups, jGroups, 3, mode, 4);
+        EXPECT_EQ(actual.j_coverage_status, expected.j_coverage_status);
+        EXPECT_EQ(actual.j_covered_s_counts, expected.j_covered_s_counts);
+    }
+
+    EXPECT_EQ(generator->generateParallel(samples, 5, 4), generator->generate(samples, 5));
+}
+
+} // namespace
+} // namespace core_algo
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}